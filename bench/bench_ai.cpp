@@ -0,0 +1,90 @@
+// 贪心 AI 基准：无界面地跑大量对局，统计每秒决策数、单次决策耗时与平均得分
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_ai.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_ai
+// 运行:
+//   build/bench_ai [每种模式的对局数=1000] [决策预算微秒=200] [地图宽=30] [地图高=18] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "greedy_ai.h"
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+// 单局的帧数上限，防止 AI 绕圈不吃食物导致对局不结束
+const long long maxTicksPerGame = 50000;
+
+int main(int argc, char* argv[]) {
+    int games = (argc > 1) ? atoi(argv[1]) : 1000;
+    int budget = (argc > 2) ? atoi(argv[2]) : 200;
+    int width = (argc > 3) ? atoi(argv[3]) : mapWidth;
+    int height = (argc > 4) ? atoi(argv[4]) : mapHeight;
+    unsigned int seed = (argc > 5) ? (unsigned int)strtoul(argv[5], nullptr, 10) : 1;
+
+    const GameState modes[2] = { singleMode, pairMode };
+    const GameVersion versions[3] = { beginner, advanced, expert };
+    const char* modeNames[2] = { "single", "pair" };
+    const char* versionNames[3] = { "beginner", "advanced", "expert" };
+
+    printf("board %dx%d, %d games per row, budget %d us\n", width, height, games, budget);
+    // decisions/sec 只计决策本身的耗时，games/sec 包含规则引擎推进
+    printf("%-8s %-9s %12s %14s %10s %10s %8s %10s %10s %10s %8s\n",
+        "mode", "version", "decisions", "decisions/sec", "avg us", "max us", "over",
+        "games/sec", "ai score", "rand score", "capped");
+
+    for (int m = 0; m < 2; ++m) {
+        for (int v = 0; v < 3; ++v) {
+            Simulation sim(width, height);
+            // 单人模式 AI 控制玩家1；双人模式 AI 控制玩家1，玩家2 使用随机脚本作为对照
+            ScriptedInput scripted(seed);
+            GreedyAI ai(sim, 1, &scripted, budget);
+
+            long long score1 = 0, score2 = 0, capped = 0;
+            auto begin = chrono::steady_clock::now();
+            for (int g = 0; g < games; ++g) {
+                sim.init(modes[m], versions[v], seed + g);
+                while (!sim.isEnded() && sim.getTickCount() < maxTicksPerGame) {
+                    sim.update(ai);
+                }
+                if (!sim.isEnded()) {
+                    ++capped;
+                }
+                score1 += sim.getScore1();
+                score2 += sim.getScore2();
+            }
+            double sec = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+            const TimingStat& t = ai.getDecisionTime();
+            char randScore[16] = "-";
+            if (modes[m] == pairMode) {
+                snprintf(randScore, sizeof(randScore), "%.1f", (double)score2 / games);
+            }
+            printf("%-8s %-9s %12lld %14.0f %10.2f %10.2f %8lld %10.1f %10.1f %10s %8lld\n",
+                modeNames[m], versionNames[v], t.count, t.count * 1000 / t.total,
+                t.average() * 1000, t.maxValue * 1000, ai.getOverBudget(),
+                games / sec, (double)score1 / games, randScore, capped);
+        }
+    }
+
+    // 对照：同样的对局全部由随机脚本控制
+    printf("\nbaseline (scripted input only)\n");
+    for (int v = 0; v < 3; ++v) {
+        Simulation sim(width, height);
+        ScriptedInput scripted(seed);
+        long long score = 0;
+        for (int g = 0; g < games; ++g) {
+            sim.init(singleMode, versions[v], seed + g);
+            while (!sim.isEnded()) {
+                sim.update(scripted);
+            }
+            score += sim.getScore1();
+        }
+        printf("%-8s %-9s %10.1f\n", "single", versionNames[v], (double)score / games);
+    }
+    return 0;
+}
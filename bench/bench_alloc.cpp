@@ -0,0 +1,164 @@
+// 内存分配计数：替换全局 operator new 统计堆分配次数，核对对局稳定后每帧与每次开局都不再分配内存
+// 对局用到的容器都由对象持有、跨局复用（清空但保留容量），第一局把容量扩到位后就不再向堆申请
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_alloc.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_alloc
+// 运行:
+//   build/bench_alloc [每行推进的帧数=1000000] [随机种子=1]
+// 稳定后仍有分配时返回 1
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "arena.h"
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+namespace {
+
+long long allocCount = 0;
+
+// 随机转向的电脑蛇：每次移动有三分之一的概率换个方向
+class RandomTurns : public ArenaInput {
+private:
+    Rng rng;
+
+public:
+    explicit RandomTurns(uint64_t seed) : rng(seed, 1) {
+    }
+
+    Direction getTurn(const Arena&, int) override {
+        return (rng.below(3) == 0) ? static_cast<Direction>(rng.below(4) + 1) : stop;
+    }
+};
+
+// 一行的统计：第一局（含构造）的分配、之后开局与推进帧时的分配
+struct AllocRow {
+    long long games;
+    long long warmup;
+    long long init;
+    long long tick;
+
+    AllocRow() : games(0), warmup(0), init(0), tick(0) {
+    }
+};
+
+void printRow(const char* engine, const char* config, const AllocRow& r) {
+    printf("%-8s %-16s %8lld %10lld %10lld %10lld\n", engine, config, r.games, r.warmup, r.init, r.tick);
+}
+
+}
+
+void* operator new(size_t size) {
+    ++allocCount;
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw bad_alloc();
+    }
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+int main(int argc, char* argv[]) {
+    long long ticks = (argc > 1) ? atoll(argv[1]) : 1000000;
+    unsigned int seed = (argc > 2) ? (unsigned int)strtoul(argv[2], nullptr, 10) : 1;
+
+    const GameState modes[2] = { singleMode, pairMode };
+    const GameVersion versions[3] = { beginner, advanced, expert };
+    const char* modeNames[2] = { "single", "pair" };
+    const char* versionNames[3] = { "beginner", "advanced", "expert" };
+
+    printf("heap allocations, %lld ticks per row after the first game\n", ticks);
+    printf("%-8s %-16s %8s %10s %10s %10s\n", "engine", "config", "games", "first game", "init", "tick");
+
+    bool clean = true;
+    char config[32];
+
+    // 规则引擎：与界面相同，开启变化格子记录并每帧清除
+    for (int m = 0; m < 2; ++m) {
+        for (int v = 0; v < 3; ++v) {
+            AllocRow r;
+            long long before = allocCount;
+            Simulation sim;
+            ScriptedInput input(seed);
+            sim.setDirtyTracking(true);
+            sim.init(modes[m], versions[v], seed);
+            while (!sim.isEnded()) {
+                sim.update(input);
+                sim.clearDirty();
+            }
+            r.warmup = allocCount - before;
+
+            for (long long t = 0; t < ticks; ++t) {
+                if (sim.isEnded()) {
+                    ++r.games;
+                    before = allocCount;
+                    sim.init(modes[m], versions[v], seed + r.games);
+                    r.init += allocCount - before;
+                }
+                before = allocCount;
+                sim.update(input);
+                sim.clearDirty();
+                r.tick += allocCount - before;
+            }
+            snprintf(config, sizeof(config), "%s/%s", modeNames[m], versionNames[v]);
+            printRow("sim", config, r);
+            clean = clean && r.init == 0 && r.tick == 0;
+        }
+    }
+
+    // 多蛇竞技场：蛇身缓冲区只在某条蛇长过以往所有局时才会翻倍
+    const int counts[] = { 8, 64 };
+    for (int count : counts) {
+        AllocRow r;
+        long long before = allocCount;
+        Arena arena(60, 60);
+        RandomTurns bots(seed);
+        arena.init(count, expert, seed);
+        while (!arena.isEnded()) {
+            arena.update(bots);
+        }
+        r.warmup = allocCount - before;
+
+        for (long long t = 0; t < ticks; ++t) {
+            if (arena.isEnded()) {
+                ++r.games;
+                before = allocCount;
+                arena.init(count, expert, seed + r.games);
+                r.init += allocCount - before;
+            }
+            before = allocCount;
+            arena.update(bots);
+            r.tick += allocCount - before;
+        }
+        snprintf(config, sizeof(config), "%d snakes 60x60", count);
+        printRow("arena", config, r);
+        clean = clean && r.init == 0 && r.tick == 0;
+    }
+
+    printf("%s\n", clean ? "steady state: no heap allocations" : "steady state: heap allocations found");
+    return clean ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// 多蛇竞技场基准：蛇数从 2 到 256，测每帧耗时与每次移动的耗时，
+// 并用逐对比较的做法核对蛇头相撞的判定（同时给出两两比较的耗时作对照）
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_arena.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_arena
+// 运行:
+//   build/bench_arena [每种蛇数推进的帧数=200000] [地图边长=160] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "ai_input.h"
+#include "arena.h"
+
+using namespace std;
+
+namespace {
+
+// 用随机安全策略的电脑蛇，与蒙特卡洛树搜索的模拟相同
+class RandomBots : public ArenaInput {
+private:
+    Rng rng;
+
+public:
+    explicit RandomBots(uint64_t seed) : rng(seed, 1) {
+    }
+
+    Direction getTurn(const Arena& arena, int index) override {
+        return AIInput::randomSafeTurn(arena.getMap(), arena.getSnake(index), rng);
+    }
+};
+
+}
+
+int main(int argc, char* argv[]) {
+    long long ticks = (argc > 1) ? atoll(argv[1]) : 200000;
+    int side = (argc > 2) ? atoi(argv[2]) : 160;
+    unsigned int seed = (argc > 3) ? (unsigned int)strtoul(argv[3], nullptr, 10) : 1;
+
+    printf("board %dx%d, expert rules, %lld ticks per row\n", side, side, ticks);
+    printf("%-7s %8s %10s %10s %12s %10s %10s %14s %10s\n",
+        "snakes", "games", "moves", "head-on", "ns/tick", "ns/move", "mismatch", "pairwise ns", "ns/pair");
+
+    const int counts[] = { 2, 8, 32, 64, 128, 256 };
+    for (int count : counts) {
+        Arena arena(side, side);
+        RandomBots bots(seed);
+        arena.init(count, expert, seed);
+
+        vector<int> oldHead(count);
+        long long moves = 0, headOns = 0, mismatches = 0, games = 1, pairs = 0;
+        double arenaNs = 0, pairwiseNs = 0;
+        for (long long t = 0; t < ticks; ++t) {
+            if (arena.isEnded()) {
+                arena.init(count, expert, seed + games++);
+            }
+            for (int i = 0; i < count; ++i) {
+                auto h = arena.getSnake(i).getHeadPos();
+                oldHead[i] = arena.getSnake(i).getBody().empty() ? -1 : arena.getMap().index(h.first, h.second);
+            }
+
+            auto begin = chrono::steady_clock::now();
+            arena.update(bots);
+            auto mid = chrono::steady_clock::now();
+
+            // 两两比较：移动的蛇新蛇头相同，或新蛇头落在别的蛇的蛇头上，双方都算蛇头相撞
+            int n = arena.getSnakeCount();
+            vector<char> expected(n, 0);
+            for (int i = 0; i < n; ++i) {
+                int c = arena.getNewHead(i);
+                if (c < 0) {
+                    continue;
+                }
+                for (int j = 0; j < n; ++j) {
+                    if (j != i && (c == arena.getNewHead(j) || c == oldHead[j])) {
+                        expected[i] = expected[j] = 1;
+                    }
+                }
+            }
+            auto end = chrono::steady_clock::now();
+            arenaNs += chrono::duration<double, nano>(mid - begin).count();
+            pairwiseNs += chrono::duration<double, nano>(end - mid).count();
+            pairs += (long long)n * (n - 1);
+
+            for (int i = 0; i < n; ++i) {
+                bool headOn = arena.getFate(i) == Arena::headOn;
+                if (arena.getNewHead(i) >= 0) {
+                    ++moves;
+                }
+                headOns += headOn;
+                if (headOn != (expected[i] != 0)) {
+                    ++mismatches;
+                }
+            }
+        }
+        printf("%-7d %8lld %10lld %10lld %12.1f %10.1f %10lld %14.1f %10.2f\n", count, games, moves, headOns,
+            arenaNs / ticks, moves ? arenaNs / moves : 0.0, mismatches, pairwiseNs / ticks, pairs ? pairwiseNs / pairs : 0.0);
+    }
+    return 0;
+}
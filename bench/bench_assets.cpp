@@ -0,0 +1,84 @@
+// 资源加载基准：并行解码 pictures 目录、贴图缩放、图集打包
+// Linux 下没有 PNG 解码器，这里读取整个文件并按 PNG 头里的尺寸生成像素代替解码，
+// 测的是读文件、透明度合成、缩放、打包这一整条流程在不同线程数下的耗时
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_assets.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_assets
+// 运行:
+//   build/bench_assets [图片目录=pictures] [贴图边长=40] [重复次数=20]
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assets.h"
+#include "thread_pool.h"
+
+using namespace std;
+
+// 读取文件，用 PNG 头中的宽高生成一张由文件内容决定的像素图
+static bool fakeDecode(const string& path, PixelImage& out) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        return false;
+    }
+    vector<unsigned char> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (data.size() < 24 || data[1] != 'P' || data[2] != 'N' || data[3] != 'G') {
+        return false;
+    }
+    int w = (data[16] << 24) | (data[17] << 16) | (data[18] << 8) | data[19];
+    int h = (data[20] << 24) | (data[21] << 16) | (data[22] << 8) | data[23];
+    out = PixelImage(w, h);
+    for (size_t i = 0; i < out.pixels.size(); ++i) {
+        uint32_t v = data[i % data.size()];
+        out.pixels[i] = 0xFF000000u | (v << 16) | ((v * 7) & 0xFF) << 8 | ((v * 13) & 0xFF);
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    string dir = (argc > 1) ? argv[1] : "pictures";
+    int spriteSize = (argc > 2) ? atoi(argv[2]) : gridSize;
+    int repeat = (argc > 3) ? atoi(argv[3]) : 20;
+
+    const char* sprites[] = { "snake_head1.png", "snake_head2.png",
+        "food1.png", "food2.png", "food3.png", "food4.png", "food5.png" };
+    const char* backgrounds[] = { "menuBg.png", "menuBg1.png", "menuBg2.png", "menuBg3.png", "menuBg4.png",
+        "selectBg1.png", "selectBg2.png", "selectBg3.png", "selectBg4.png" };
+
+    int hardware = max(1u, thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardware; threads *= 2) {
+        ThreadPool pool(threads);
+        double total = 0;
+        AssetManager assets(spriteSize);
+        for (int r = 0; r < repeat; ++r) {
+            assets = AssetManager(spriteSize);
+            for (const char* f : sprites) {
+                assets.add(f, assetSprite);
+            }
+            for (const char* f : backgrounds) {
+                assets.add(f, assetBackground);
+            }
+            assets.loadAll(dir, pool, fakeDecode);
+            total += assets.getLoadMs();
+        }
+        printf("threads %2d  %8.2f ms per load  atlas %dx%d\n", threads, total / repeat,
+            assets.getAtlas().width, assets.getAtlas().height);
+        if (threads == 1) {
+            for (int i = 0; i < 7; ++i) {
+                const AtlasRect& rc = assets.getRect(i);
+                printf("  %-16s %s at (%d,%d) %dx%d\n", sprites[i], assets.isLoaded(i) ? "ok" : "missing",
+                    rc.x, rc.y, rc.w, rc.h);
+            }
+            for (const auto& f : assets.getFailed()) {
+                printf("  failed: %s\n", f.c_str());
+            }
+        }
+    }
+    return 0;
+}
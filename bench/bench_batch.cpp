@@ -0,0 +1,60 @@
+// 批量模拟基准：N 块独立棋盘在线程池上并行推进，统计 1 到全部线程的吞吐量与加速比
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_batch.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_batch
+// 运行:
+//   build/bench_batch [棋盘数=4096] [锁步轮数=50] [每轮帧数=100] [每块棋盘独立对局数=4]
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "batch.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    int boardCount = (argc > 1) ? atoi(argv[1]) : 4096;
+    int steps = (argc > 2) ? atoi(argv[2]) : 50;
+    int ticksPerStep = (argc > 3) ? atoi(argv[3]) : 100;
+    int gamesPerBoard = (argc > 4) ? atoi(argv[4]) : 4;
+
+    int maxThreads = static_cast<int>(thread::hardware_concurrency());
+    if (maxThreads <= 0) {
+        maxThreads = 1;
+    }
+    vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(maxThreads);
+
+    printf("%d boards, pair/expert, %d hardware threads\n", boardCount, maxThreads);
+    printf("%-12s %8s %14s %14s %10s\n", "run", "threads", "games/sec", "ticks/sec", "speedup");
+
+    double lockstepBase = 0, independentBase = 0;
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+
+        BatchRunner lockstep(boardCount, pairMode, expert);
+        BatchStats s = lockstep.runLockstep(pool, steps, ticksPerStep);
+        double tps = s.ticks / s.seconds;
+        if (lockstepBase == 0) {
+            lockstepBase = tps;
+        }
+        printf("%-12s %8d %14.0f %14.0f %10.2f\n", "lockstep", threads,
+            s.games / s.seconds, tps, tps / lockstepBase);
+
+        BatchRunner independent(boardCount, pairMode, expert);
+        s = independent.runIndependent(pool, gamesPerBoard);
+        tps = s.ticks / s.seconds;
+        if (independentBase == 0) {
+            independentBase = tps;
+        }
+        printf("%-12s %8d %14.0f %14.0f %10.2f\n", "independent", threads,
+            s.games / s.seconds, tps, tps / independentBase);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+// 哈密顿环 AI 基准：构造环的耗时（最大到 1000x1000）、每步决策耗时、整局能否铺满地图
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_hamilton.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_hamilton
+// 运行:
+//   build/bench_hamilton [整局对局数=100] [大地图上推进的帧数=3000000] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "hamilton_ai.h"
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+// 检查环：每个后继都与自己相邻，沿环走一圈正好经过 getCycleLength 个格子
+// covered 返回有后继的格子数（包括角上的绕行格）
+bool verifyCycle(const HamiltonAI& ai, const GameMap& map, int& covered) {
+    int start = -1;
+    covered = 0;
+    for (int c = 0; c < map.getCellCount(); ++c) {
+        int n = ai.getNext(c);
+        if (n < 0) {
+            continue;
+        }
+        ++covered;
+        if (start < 0) {
+            start = c;
+        }
+        auto a = map.position(c), b = map.position(n);
+        if (abs(a.first - b.first) + abs(a.second - b.second) != 1 || map.get(b.first, b.second) == wall) {
+            return false;
+        }
+    }
+    if (start < 0) {
+        return false;
+    }
+    int steps = 0, c = start;
+    do {
+        c = ai.getNext(c);
+        ++steps;
+    } while (c != start && steps <= covered);
+    return steps == ai.getCycleLength() && covered - steps <= 1;
+}
+
+int main(int argc, char* argv[]) {
+    int games = (argc > 1) ? atoi(argv[1]) : 100;
+    long long ticks = (argc > 2) ? atoll(argv[2]) : 3000000;
+    unsigned int seed = (argc > 3) ? (unsigned int)strtoul(argv[3], nullptr, 10) : 1;
+
+    // 1. 各尺寸地图上构造环的耗时与每步决策耗时
+    const int sizes[][2] = { { 30, 18 }, { 31, 19 }, { 100, 100 }, { 257, 300 }, { 1000, 1000 }, { 999, 777 } };
+    printf("%-10s %9s %9s %9s %8s %12s %10s %10s %10s %10s\n",
+        "board", "cycle", "covered", "interior", "valid", "build ms", "decisions", "avg ns", "max us", "shortcuts");
+    for (auto& size : sizes) {
+        int w = size[0], h = size[1];
+        Simulation sim(w, h);
+        HamiltonAI ai(sim, 1);
+        sim.init(singleMode, advanced, seed);
+        // 构造环发生在第一次决策时，单独记下耗时后清空统计，之后的决策耗时不含构造
+        while (ai.getDecisionTime().count == 0 && !sim.isEnded()) {
+            sim.update(ai);
+        }
+        double buildMs = ai.getBuildTime().total;
+        ai.resetStats();
+        for (long long t = 0; t < ticks && !sim.isEnded(); ++t) {
+            sim.update(ai);
+        }
+        const TimingStat& d = ai.getDecisionTime();
+        char board[16];
+        snprintf(board, sizeof(board), "%dx%d", w, h);
+        int covered = 0;
+        bool valid = verifyCycle(ai, sim.getMap(), covered);
+        printf("%-10s %9d %9d %9d %8s %12.2f %10lld %10.1f %10.2f %10lld\n",
+            board, ai.getCycleLength(), covered, (w - 2) * (h - 2), valid ? "yes" : "NO",
+            buildMs, d.count, d.average() * 1e6, d.maxValue * 1000, ai.getShortcuts());
+    }
+
+    // 2. 单人整局：进阶版和高级版应当一直不死，直到地图铺满
+    printf("\n%-10s %-9s %6s %8s %14s %10s %12s\n", "board", "version", "games", "filled", "avg ticks", "deaths", "avg score");
+    const GameVersion versions[2] = { advanced, expert };
+    const char* versionNames[2] = { "advanced", "expert" };
+    const int gameSizes[][2] = { { 30, 18 }, { 21, 15 } };
+    for (auto& size : gameSizes) {
+        for (int v = 0; v < 2; ++v) {
+            int w = size[0], h = size[1];
+            Simulation sim(w, h);
+            HamiltonAI ai(sim, 1);
+            long long totalTicks = 0, deaths = 0, score = 0;
+            int filled = 0;
+            for (int g = 0; g < games; ++g) {
+                sim.init(singleMode, versions[v], seed + g);
+                int lives = sim.getSnake1().getLife();
+                while (!sim.isEnded()) {
+                    sim.update(ai);
+                }
+                deaths += lives - sim.getSnake1().getLife();
+                if (sim.getMap().getFreeCount() == 0) {
+                    ++filled;
+                }
+                totalTicks += sim.getTickCount();
+                score += sim.getScore1();
+            }
+            char board[16];
+            snprintf(board, sizeof(board), "%dx%d", w, h);
+            printf("%-10s %-9s %6d %8d %14.0f %10lld %12.1f\n", board, versionNames[v], games, filled,
+                (double)totalTicks / games, deaths, (double)score / games);
+        }
+    }
+
+    // 3. 双人进阶版，对手用随机脚本：对手的尸体变成墙后需要重新构造环
+    {
+        Simulation sim(30, 18);
+        ScriptedInput scripted(seed);
+        HamiltonAI ai(sim, 1, &scripted);
+        long long deaths = 0;
+        for (int g = 0; g < games; ++g) {
+            sim.init(pairMode, advanced, seed + g);
+            int lives = sim.getSnake1().getLife();
+            // 对手不断死亡变墙，场地被切碎后 AI 也可能被困住，限定帧数
+            for (long long t = 0; t < 200000 && !sim.isEnded(); ++t) {
+                sim.update(ai);
+            }
+            deaths += lives - sim.getSnake1().getLife();
+        }
+        const TimingStat& b = ai.getBuildTime();
+        printf("\npair advanced vs scripted, 30x18: %d games, %lld rebuilds, avg %.3f ms, max %.3f ms, %lld AI deaths\n",
+            games, b.count, b.average(), b.maxValue, deaths);
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+// 输入队列基准：一个线程写、一个线程读，检查顺序并测吞吐量与入队到出队的延迟
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_input.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_input
+// 运行:
+//   build/bench_input [元素个数=5000000]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "spsc_queue.h"
+#include "timing.h"
+
+using namespace std;
+
+struct Event {
+    long long seq;
+    chrono::steady_clock::time_point time;
+};
+
+int main(int argc, char* argv[]) {
+    long long count = (argc > 1) ? atoll(argv[1]) : 5000000;
+
+    // 与界面相同的容量
+    static SpscQueue<Event, 64> queue;
+    TimingStat latency;
+    long long outOfOrder = 0;
+
+    auto begin = chrono::steady_clock::now();
+    thread producer([&] {
+        for (long long i = 0; i < count; ++i) {
+            Event e{ i, chrono::steady_clock::now() };
+            while (!queue.push(e)) {
+                this_thread::yield();
+            }
+        }
+    });
+
+    long long expected = 0;
+    while (expected < count) {
+        Event e;
+        if (!queue.pop(e)) {
+            this_thread::yield();
+            continue;
+        }
+        latency.add(elapsedMs(e.time, chrono::steady_clock::now()));
+        outOfOrder += e.seq != expected;
+        ++expected;
+    }
+    producer.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    printf("%lld events in %.3f s, %.1f M events/s\n", count, seconds, count / seconds / 1e6);
+    printf("queue latency avg %.4f ms, max %.4f ms\n", latency.average(), latency.maxValue);
+    printf("%lld out of order\n", outOfOrder);
+    return outOfOrder ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+// 蒙特卡洛树搜索 AI 基准：复制对局的耗时、每秒模拟次数随线程数的变化，以及与贪心 AI 对战的胜负
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_mcts.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_mcts
+// 运行:
+//   build/bench_mcts [每种版本的对局数=10] [决策预算微秒=2000] [最多线程数=硬件线程数] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "greedy_ai.h"
+#include "mcts_ai.h"
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+// 单局的帧数上限，防止双方都绕圈不吃食物导致对局不结束
+const long long maxTicksPerGame = 20000;
+
+int main(int argc, char* argv[]) {
+    int games = (argc > 1) ? atoi(argv[1]) : 10;
+    int budget = (argc > 2) ? atoi(argv[2]) : 2000;
+    int maxThreads = (argc > 3) ? atoi(argv[3]) : static_cast<int>(thread::hardware_concurrency());
+    unsigned int seed = (argc > 4) ? (unsigned int)strtoul(argv[4], nullptr, 10) : 1;
+    if (maxThreads <= 0) {
+        maxThreads = 1;
+    }
+
+    // 1. 复制对局：从双人对局的中盘局面反复复制到同一个已分配好的副本里
+    printf("%-10s %12s %12s\n", "board", "clones", "ns/clone");
+    const int sizes[][2] = { { 30, 18 }, { 60, 40 }, { 100, 100 } };
+    for (auto& size : sizes) {
+        Simulation sim(size[0], size[1]), copy(size[0], size[1]);
+        ScriptedInput scripted(seed);
+        sim.init(pairMode, expert, seed);
+        for (int t = 0; t < 2000 && !sim.isEnded(); ++t) {
+            sim.update(scripted);
+        }
+        const int clones = 200000;
+        long long check = 0;
+        auto begin = chrono::steady_clock::now();
+        for (int i = 0; i < clones; ++i) {
+            copy = sim;
+            check += copy.getTickCount();
+        }
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count() / clones;
+        char board[16];
+        snprintf(board, sizeof(board), "%dx%d", size[0], size[1]);
+        printf("%-10s %12d %12.1f%s\n", board, clones, ns, check == 0 ? " ?" : "");
+    }
+
+    // 2. 每秒模拟次数随线程数的变化：双人高级版，贪心 AI 控制玩家1，MCTS 控制玩家2，各做相同次数的决策
+    const int decisions = 200;
+    printf("\nthreads, %d decisions of %d us each (pair expert 30x18)\n", decisions, budget);
+    printf("%-8s %12s %14s %14s %10s\n", "threads", "rollouts", "rollouts/sec", "ticks/sec", "speedup");
+    double baseRate = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ThreadPool pool(threads);
+        Simulation sim;
+        MctsAI mcts(sim, 2, pool, nullptr, budget, 30, seed);
+        GreedyAI greedy(sim, 1, &mcts);
+        sim.init(pairMode, expert, seed);
+        while (mcts.getDecisionTime().count < decisions) {
+            if (sim.isEnded()) {
+                sim.init(pairMode, expert, seed + mcts.getDecisionTime().count);
+            }
+            sim.update(greedy);
+        }
+        double sec = mcts.getDecisionTime().total / 1000;
+        double rate = mcts.getRollouts() / sec;
+        if (threads == 1) {
+            baseRate = rate;
+        }
+        printf("%-8d %12lld %14.0f %14.0f %10.2f\n", threads, mcts.getRollouts(), rate,
+            mcts.getRolloutTicks() / sec, rate / baseRate);
+        if (threads < maxThreads && threads * 2 > maxThreads) {
+            threads = maxThreads / 2;
+        }
+    }
+
+    // 3. 对战：MCTS（玩家2）对贪心 AI（玩家1），按得分判胜负
+    ThreadPool pool(maxThreads);
+    printf("\nmcts (player 2, %d threads, %d us) vs greedy (player 1), 30x18, %d games per row\n",
+        pool.size(), budget, games);
+    printf("%-9s %8s %8s %8s %12s %12s %10s %8s\n",
+        "version", "mcts win", "greedy", "ties", "mcts score", "greedy score", "rollouts", "capped");
+    const GameVersion versions[3] = { beginner, advanced, expert };
+    const char* versionNames[3] = { "beginner", "advanced", "expert" };
+    for (int v = 0; v < 3; ++v) {
+        Simulation sim;
+        MctsAI mcts(sim, 2, pool, nullptr, budget, 30, seed);
+        GreedyAI greedy(sim, 1, &mcts);
+        int wins = 0, losses = 0, ties = 0, capped = 0;
+        long long score1 = 0, score2 = 0;
+        for (int g = 0; g < games; ++g) {
+            sim.init(pairMode, versions[v], seed + g);
+            while (!sim.isEnded() && sim.getTickCount() < maxTicksPerGame) {
+                sim.update(greedy);
+            }
+            if (!sim.isEnded()) {
+                ++capped;
+            }
+            score1 += sim.getScore1();
+            score2 += sim.getScore2();
+            if (sim.getScore2() > sim.getScore1()) {
+                ++wins;
+            }
+            else if (sim.getScore2() < sim.getScore1()) {
+                ++losses;
+            }
+            else {
+                ++ties;
+            }
+        }
+        printf("%-9s %8d %8d %8d %12.1f %12.1f %10lld %8d\n", versionNames[v], wins, losses, ties,
+            (double)score2 / games, (double)score1 / games, mcts.getRollouts(), capped);
+    }
+    return 0;
+}
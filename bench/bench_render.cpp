@@ -0,0 +1,103 @@
+// 棋盘渲染基准：软件帧缓冲上对比整帧重绘（相当于 cleardevice 后全部重画）和增量重绘
+// 两边跑同一局，每帧逐像素比对，确认增量渲染的画面与整帧重绘完全一致
+// 同时统计合并横向同色格子之后每帧的绘制调用数（合并前每个格子一次调用）
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_render.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_render
+// 运行:
+//   build/bench_render [每种模式的渲染帧数=5000] [每帧逻辑帧数=2] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "framebuffer.h"
+#include "renderer.h"
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+// 生成纯色贴图代替图片资源
+static void setTestSprites(Framebuffer& fb) {
+    for (int s = 0; s < spriteCount; ++s) {
+        PixelImage img(gridSize, gridSize, 0x101010u * (s + 1));
+        // 加一条斜线，贴图错位时比对能发现
+        for (int i = 0; i < gridSize; ++i) {
+            img.pixels[i * gridSize + i] = 0xFFFF00;
+        }
+        fb.setSprite(s, img);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    long long frames = (argc > 1) ? atoll(argv[1]) : 5000;
+    int ticksPerFrame = (argc > 2) ? atoi(argv[2]) : 2;
+    uint64_t seed = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 1;
+
+    const GameVersion versions[3] = { beginner, advanced, expert };
+    const char* versionNames[3] = { "beginner", "advanced", "expert" };
+    int boardW = mapWidth * gridSize, boardH = mapHeight * gridSize;
+    printf("board %dx%d cells, %dx%d pixels, %d ticks per frame\n", mapWidth, mapHeight, boardW, boardH, ticksPerFrame);
+
+    int failures = 0;
+    for (int v = 0; v < 3; ++v) {
+        Simulation fullSim, dirtySim;
+        Framebuffer fullFb(boardW, boardH), dirtyFb(boardW, boardH);
+        setTestSprites(fullFb);
+        setTestSprites(dirtyFb);
+        BoardRenderer fullRenderer, dirtyRenderer;
+        fullSim.setDirtyTracking(true);
+        dirtySim.setDirtyTracking(true);
+
+        uint64_t gameSeed = seed;
+        fullSim.init(pairMode, versions[v], gameSeed);
+        dirtySim.init(pairMode, versions[v], gameSeed);
+        ScriptedInput fullInput(gameSeed), dirtyInput(gameSeed);
+
+        double fullNs = 0, dirtyNs = 0;
+        long long dirtyCells = 0, mismatches = 0, games = 1;
+        long long fullCalls = 0, dirtyCalls = 0, fullRects = 0;
+        for (long long f = 0; f < frames; ++f) {
+            for (int t = 0; t < ticksPerFrame; ++t) {
+                fullSim.update(fullInput);
+                dirtySim.update(dirtyInput);
+            }
+            if (dirtySim.isEnded()) {
+                ++games;
+                gameSeed = seed + games;
+                fullSim.init(pairMode, versions[v], gameSeed);
+                dirtySim.init(pairMode, versions[v], gameSeed);
+                fullInput = ScriptedInput(gameSeed);
+                dirtyInput = ScriptedInput(gameSeed);
+            }
+
+            auto t0 = chrono::steady_clock::now();
+            fullFb.clear(colorBackground);
+            fullRenderer.invalidate();
+            fullRenderer.draw(fullSim, fullFb);
+            fullCalls += fullRenderer.getLastCalls();
+            fullRects += fullRenderer.getLastRects();
+            auto t1 = chrono::steady_clock::now();
+            dirtyCells += dirtyRenderer.draw(dirtySim, dirtyFb);
+            dirtyCalls += dirtyRenderer.getLastCalls();
+            auto t2 = chrono::steady_clock::now();
+            fullNs += chrono::duration<double, nano>(t1 - t0).count();
+            dirtyNs += chrono::duration<double, nano>(t2 - t1).count();
+
+            if (fullFb.getImage().pixels != dirtyFb.getImage().pixels) {
+                ++mismatches;
+            }
+        }
+        failures += mismatches > 0;
+
+        printf("%-8s games %lld\n", versionNames[v], games);
+        printf("  full   %9.0f ns/frame %9.0f px/frame %6d cells/frame %7.2f rects/frame %5.2f calls/frame\n", fullNs / frames,
+            (double)fullFb.getPixelsWritten() / frames, mapWidth * mapHeight, (double)fullRects / frames, (double)fullCalls / frames);
+        printf("  dirty  %9.0f ns/frame %9.0f px/frame %6.2f cells/frame %7.2f calls/frame  (%.1fx)\n", dirtyNs / frames,
+            (double)dirtyFb.getPixelsWritten() / frames, (double)dirtyCells / frames, (double)dirtyCalls / frames, fullNs / dirtyNs);
+        printf("  mismatched frames %lld\n", mismatches);
+    }
+    return failures ? 1 : 0;
+}
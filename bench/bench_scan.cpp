@@ -0,0 +1,105 @@
+// 地图扫描内核基准：标量 / SSE2 / AVX2 三个版本的计数、找第 n 个、整图填充
+// 先与逐格遍历（forEachCell）的结果比对，再分别计时
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_scan.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_scan
+// 运行:
+//   build/bench_scan [每项重复次数=2000] [随机种子=1]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "boardscan.h"
+#include "gamemap.h"
+#include "rng.h"
+
+using namespace std;
+
+// 逐格遍历的参照实现
+static int countLoop(const GameMap& map, MapElement e) {
+    int result = 0;
+    map.forEachCell([&](int, int, MapElement cell) {
+        result += cell == e;
+    });
+    return result;
+}
+
+template <typename F>
+static double timeNs(int repeat, F&& f) {
+    auto begin = chrono::steady_clock::now();
+    for (int i = 0; i < repeat; ++i) {
+        f(i);
+    }
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - begin).count() / repeat;
+}
+
+int main(int argc, char* argv[]) {
+    int repeat = (argc > 1) ? atoi(argv[1]) : 2000;
+    uint64_t seed = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 1;
+
+    vector<const BoardKernels*> kernels = { &scalarKernels(), sse2Kernels(), avx2Kernels() };
+    printf("dispatch picks %s\n", boardKernels().name);
+
+    const int sizes[][2] = { { mapWidth, mapHeight }, { 255, 255 }, { 1000, 1000 } };
+    int failures = 0;
+    volatile int sink = 0;
+    for (const auto& size : sizes) {
+        GameMap map(size[0], size[1]);
+        int cells = map.getCellCount();
+        // 随机铺上约一半的墙、蛇身和食物
+        Rng rng(seed);
+        for (int c = 0; c < cells; ++c) {
+            int r = rng.below(8);
+            map.setCell(c, r < 4 ? emptyInfo : static_cast<MapElement>(r - 3 > 4 ? 4 : r - 3));
+        }
+        int empty = countLoop(map, emptyInfo);
+        printf("board %dx%d, %d empty\n", size[0], size[1], empty);
+
+        // 逐格遍历作为参照
+        double loopCount = timeNs(repeat, [&](int) { sink = countLoop(map, emptyInfo); });
+        printf("  %-7s count %10.0f ns\n", "loop", loopCount);
+
+        for (const BoardKernels* k : kernels) {
+            if (k == nullptr) {
+                continue;
+            }
+            const vector<uint8_t>& buffer = map.getPacked();
+
+            // 正确性：计数、每隔若干个取第 n 个
+            for (int e = 0; e <= 4; ++e) {
+                if (k->count(buffer.data(), cells, static_cast<uint8_t>(e)) != countLoop(map, static_cast<MapElement>(e))) {
+                    printf("  %s count mismatch for element %d\n", k->name, e);
+                    ++failures;
+                }
+            }
+            for (int n = 0; n <= empty; n += 1 + empty / 97) {
+                int got = k->findNth(buffer.data(), cells, emptyInfo, n);
+                int want = scalarKernels().findNth(buffer.data(), cells, emptyInfo, n);
+                if (got != want) {
+                    printf("  %s findNth(%d) = %d, want %d\n", k->name, n, got, want);
+                    ++failures;
+                }
+            }
+            if (k->findNth(buffer.data(), cells, emptyInfo, empty) != -1) {
+                printf("  %s findNth past the end should fail\n", k->name);
+                ++failures;
+            }
+
+            double countNs = timeNs(repeat, [&](int) { sink = k->count(buffer.data(), cells, emptyInfo); });
+            Rng pick(seed);
+            double findNs = timeNs(repeat, [&](int) { sink = k->findNth(buffer.data(), cells, emptyInfo, pick.below(empty)); });
+            vector<uint8_t> scratch(buffer.size());
+            double fillNs = timeNs(repeat, [&](int i) { k->fill(scratch.data(), cells, static_cast<uint8_t>(i & 3)); });
+            if (k->count(scratch.data(), cells, static_cast<uint8_t>((repeat - 1) & 3)) != cells) {
+                printf("  %s fill mismatch\n", k->name);
+                ++failures;
+            }
+            printf("  %-7s count %10.0f ns  findNth %10.0f ns  fill %9.0f ns\n", k->name, countNs, findNs, fillNs);
+        }
+    }
+    printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
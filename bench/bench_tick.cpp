@@ -0,0 +1,99 @@
+// 规则引擎吞吐量基准：脱离 EasyX，用脚本输入驱动 Simulation，统计每秒帧数；
+// 再用只在蛇移动时转向的输入，对比逐帧推进与跳过空帧（skipIdleTicks）的速度，两者结果必须一致
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/bench_tick.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/bench_tick
+// 运行:
+//   build/bench_tick [每种模式的帧数=2000000] [随机种子=1] [地图宽=30] [地图高=18]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#include "scripted_input.h"
+#include "simulation.h"
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    long long ticks = (argc > 1) ? atoll(argv[1]) : 2000000;
+    unsigned int seed = (argc > 2) ? (unsigned int)strtoul(argv[2], nullptr, 10) : 1;
+    int width = (argc > 3) ? atoi(argv[3]) : mapWidth;
+    int height = (argc > 4) ? atoi(argv[4]) : mapHeight;
+
+    printf("board %dx%d, %zu bytes of packed cells\n", width, height, (size_t)(width * height + 1) / 2);
+
+    const GameState modes[2] = { singleMode, pairMode };
+    const GameVersion versions[3] = { beginner, advanced, expert };
+    const char* modeNames[2] = { "single", "pair" };
+    const char* versionNames[3] = { "beginner", "advanced", "expert" };
+
+    printf("%-8s %-9s %12s %8s %14s %10s %12s\n",
+        "mode", "version", "ticks", "games", "ticks/sec", "ns/tick", "checksum");
+
+    for (int m = 0; m < 2; ++m) {
+        for (int v = 0; v < 3; ++v) {
+            ScriptedInput input(seed);
+            Simulation sim(width, height);
+            sim.init(modes[m], versions[v], seed);
+
+            long long games = 0;
+            long long checksum = 0;
+            auto begin = chrono::steady_clock::now();
+            for (long long t = 0; t < ticks; ++t) {
+                sim.update(input);
+                if (sim.isEnded()) {
+                    checksum += sim.getScore1() + sim.getScore2() + sim.getTickCount();
+                    ++games;
+                    sim.init(modes[m], versions[v], seed + games);
+                }
+            }
+            auto end = chrono::steady_clock::now();
+
+            double sec = chrono::duration<double>(end - begin).count();
+            printf("%-8s %-9s %12lld %8lld %14.0f %10.2f %12lld\n",
+                modeNames[m], versionNames[v], ticks, games,
+                ticks / sec, sec * 1e9 / ticks, checksum);
+        }
+    }
+
+    // 同一种输入分别逐帧推进和跳过空帧，各推进 ticks 帧，核对两者结果一致
+    printf("\nmove-frame input: every tick vs skipping idle ticks\n");
+    printf("%-8s %-9s %12s %8s %14s %14s %12s %8s\n",
+        "mode", "version", "updates", "idle %", "ticks/sec", "skip ticks/s", "checksum", "match");
+    for (int m = 0; m < 2; ++m) {
+        for (int v = 0; v < 3; ++v) {
+            long long checksums[2] = { 0, 0 }, updates[2] = { 0, 0 };
+            double seconds[2] = { 0, 0 };
+            for (int skip = 0; skip < 2; ++skip) {
+                Simulation sim(width, height);
+                ScriptedInput input(seed, &sim);
+                sim.init(modes[m], versions[v], seed);
+
+                long long games = 0, done = 0;
+                auto begin = chrono::steady_clock::now();
+                while (done < ticks) {
+                    long long before = sim.getTickCount();
+                    if (skip) {
+                        sim.skipIdleTicks(ticks - done - 1);
+                    }
+                    sim.update(input);
+                    ++updates[skip];
+                    done += sim.getTickCount() - before;
+                    if (sim.isEnded()) {
+                        checksums[skip] += sim.getScore1() + sim.getScore2() + sim.getTickCount();
+                        ++games;
+                        sim.init(modes[m], versions[v], seed + games);
+                    }
+                }
+                seconds[skip] = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+            }
+            printf("%-8s %-9s %12lld %7.1f%% %14.0f %14.0f %12lld %8s\n",
+                modeNames[m], versionNames[v], updates[1], 100.0 * (ticks - updates[1]) / ticks,
+                ticks / seconds[0], ticks / seconds[1], checksums[1], checksums[0] == checksums[1] ? "yes" : "NO");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// 录像回放工具：无界面全速重放录像，校验结果并统计回放速度
+//
+// 构建（Linux）:
+//   mkdir -p build
+//   g++ -O2 -std=c++17 -pthread -Isnake bench/replay_player.cpp $(ls snake/*.cpp | grep -v main.cpp) -o build/replay_player
+// 运行:
+//   build/replay_player 录像文件... [--seek 帧]   重放录像，核对录像中记录的最终得分
+//   build/replay_player --selftest [局数=1000]    生成随机对局，录制、编码、解码后重放并核对
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "replay.h"
+#include "scripted_input.h"
+
+using namespace std;
+
+// 用脚本输入完整打一局并录像
+static Replay recordGame(GameState mode, GameVersion version, uint64_t seed, long long maxTicks) {
+    Simulation sim;
+    ScriptedInput input(seed);
+    ReplayRecorder recorder;
+    sim.init(mode, version, seed);
+    recorder.begin(sim);
+    while (!sim.isEnded() && sim.getTickCount() < maxTicks) {
+        sim.update(input);
+        recorder.record(sim);
+    }
+    recorder.finish(sim);
+    return recorder.getReplay();
+}
+
+static int selfTest(int games) {
+    const GameState modes[2] = { singleMode, pairMode };
+    const GameVersion versions[3] = { beginner, advanced, expert };
+
+    long long totalTicks = 0, totalBytes = 0, failures = 0;
+    double replaySeconds = 0;
+    for (int g = 0; g < games; ++g) {
+        Replay original = recordGame(modes[g % 2], versions[(g / 2) % 3], 1000 + g, 200000);
+        vector<uint8_t> data = original.encode();
+        totalBytes += data.size();
+
+        Replay decoded;
+        if (!decoded.decode(data)) {
+            printf("game %d: decode failed\n", g);
+            ++failures;
+            continue;
+        }
+
+        ReplayPlayer player(decoded);
+        auto begin = chrono::steady_clock::now();
+        player.runToEnd();
+        replaySeconds += chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        totalTicks += player.getTick();
+        if (!player.matchesRecord()) {
+            printf("game %d: replay diverged (score %d/%d, expected %d/%d)\n", g,
+                player.getSimulation().getScore1(), player.getSimulation().getScore2(),
+                original.score1, original.score2);
+            ++failures;
+            continue;
+        }
+
+        // 跳回中途再播放到结尾，结果必须一致
+        player.seek(original.totalTicks / 3);
+        if (player.getTick() != original.totalTicks / 3) {
+            printf("game %d: seek landed on tick %lld\n", g, player.getTick());
+            ++failures;
+            continue;
+        }
+        player.runToEnd();
+        if (!player.matchesRecord()) {
+            printf("game %d: replay diverged after seek\n", g);
+            ++failures;
+        }
+    }
+
+    printf("%d games, %lld ticks, %.1f bytes/game, replay %.0f ticks/sec, %lld failures\n",
+        games, totalTicks, (double)totalBytes / games, totalTicks / replaySeconds, failures);
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--selftest") == 0) {
+        return selfTest((argc > 2) ? atoi(argv[2]) : 1000);
+    }
+
+    long long seekTick = -1;
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+            seekTick = atoll(argv[++i]);
+        }
+        else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        printf("usage: replay_player file... [--seek tick] | --selftest [games]\n");
+        return 2;
+    }
+
+    int failures = 0;
+    for (const auto& file : files) {
+        Replay replay;
+        if (!replay.load(file)) {
+            printf("%s: cannot read replay\n", file.c_str());
+            ++failures;
+            continue;
+        }
+
+        ReplayPlayer player(replay);
+        auto begin = chrono::steady_clock::now();
+        player.runToEnd();
+        double sec = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+        bool ok = player.matchesRecord();
+        printf("%s: %lld ticks, %zu turns, score %d/%d, %.0f ticks/sec, %s\n", file.c_str(),
+            player.getTick(), replay.events.size(), player.getSimulation().getScore1(),
+            player.getSimulation().getScore2(), player.getTick() / sec, ok ? "ok" : "MISMATCH");
+        if (!ok) {
+            ++failures;
+        }
+
+        if (seekTick >= 0) {
+            begin = chrono::steady_clock::now();
+            player.seek(seekTick);
+            sec = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+            printf("  seek to %lld: score %d/%d, %.1f us\n", player.getTick(),
+                player.getSimulation().getScore1(), player.getSimulation().getScore2(), sec * 1e6);
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+#include "ai_input.h"
+
+#include <chrono>
+
+using namespace std;
+
+bool AIInput::passable(const GameMap& map, int cell, int tailCell) {
+    MapElement e = map.getCell(cell);
+    return e == emptyInfo || e == food || cell == tailCell;
+}
+
+Direction AIInput::randomSafeTurn(const GameMap& map, const Snake& s, Rng& rng) {
+    auto head = s.getHeadPos();
+    auto tail = s.getBody().back();
+    int tailCell = map.index(tail.first, tail.second);
+    Direction back = oppositeDirection(s.getDirection());
+    Direction safe[4];
+    int count = 0;
+    for (int d = up; d <= right_dir; ++d) {
+        int nx = head.first + dirX[d], ny = head.second + dirY[d];
+        if (d == back || !map.inBounds(nx, ny)) {
+            continue;
+        }
+        int cell = map.index(nx, ny);
+        if (map.getCell(cell) == food) {
+            return static_cast<Direction>(d);
+        }
+        if (passable(map, cell, tailCell)) {
+            safe[count++] = static_cast<Direction>(d);
+        }
+    }
+    return count ? safe[rng.below(count)] : stop;
+}
+
+pair<int, keyStatus> AIInput::getKey(keyStatus keyType) {
+    keyStatus mine = (player == 1) ? p1 : p2;
+    if (keyType != mine) {
+        lastFromOthers = true;
+        return others ? others->getKey(keyType) : make_pair(-1, none);
+    }
+    lastFromOthers = false;
+    // 被接管的玩家的按键直接丢弃
+    if (others) {
+        while (others->getKey(mine).second != none) {
+        }
+    }
+
+    long long tick = sim.getTickCount();
+    if (tick != decidedTick) {
+        decidedTick = tick;
+        pending = make_pair(-1, none);
+        const Snake& self = (player == 1) ? sim.getSnake1() : sim.getSnake2();
+        if (sim.isMovingThisFrame(player)) {
+            const Snake* rival = nullptr;
+            if (sim.isPair()) {
+                rival = (player == 1) ? &sim.getSnake2() : &sim.getSnake1();
+            }
+            auto begin = chrono::steady_clock::now();
+            Direction d = decide(self, rival);
+            decisionTime.add(elapsedMs(begin, chrono::steady_clock::now()));
+            if (d != stop && d != self.getDirection()) {
+                pending = keyForDirection(player, d);
+            }
+        }
+    }
+
+    auto key = pending;
+    pending = make_pair(-1, none);
+    return key;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <utility>
+
+#include "config.h"
+#include "simulation.h"
+#include "timing.h"
+
+// 电脑玩家的公共部分：作为输入源接管一名玩家，蛇每次移动前调用 decide 决定一次方向
+// 其他玩家的按键转交给 others，被接管玩家的按键直接丢弃
+class AIInput : public InputSource {
+private:
+    // 上次决策的帧号，同一帧只决策一次
+    long long decidedTick;
+    // 本帧决策出的按键，取出一次后清空
+    std::pair<int, keyStatus> pending;
+    // 决策耗时
+    TimingStat decisionTime;
+
+protected:
+    const Simulation& sim;
+    // 控制的玩家（1 或 2）
+    int player;
+    // 其他玩家的输入源（双人模式下的真人），可以为空
+    InputSource* others;
+    // 上一次返回的按键是否来自 others，读入时刻要向它查询
+    bool lastFromOthers;
+
+    // 计算这一步的方向，stop 表示保持当前方向；rival 为对手的蛇，单人模式为空
+    virtual Direction decide(const Snake& self, const Snake* rival) = 0;
+
+    // 格子能否走入：空格、食物或自己的蛇尾（移动时蛇尾会让开）
+    static bool passable(const GameMap& map, int cell, int tailCell);
+
+public:
+    AIInput(const Simulation& sim_, int player_, InputSource* others_)
+        : decidedTick(-1), pending(-1, none), sim(sim_), player(player_), others(others_), lastFromOthers(false) {
+    }
+
+    std::pair<int, keyStatus> getKey(keyStatus keyType) override;
+
+    // 其他玩家按键的读入时刻与转向生效的回调转交给 others
+    long long keyStamp() const override {
+        return (lastFromOthers && others) ? others->keyStamp() : 0;
+    }
+
+    void turnApplied(int player_, long long stamp) override {
+        if (player_ != player && others) {
+            others->turnApplied(player_, stamp);
+        }
+    }
+
+    void setOthers(InputSource* others_) {
+        others = others_;
+    }
+
+    const TimingStat& getDecisionTime() const {
+        return decisionTime;
+    }
+
+    virtual void resetStats() {
+        decisionTime.reset();
+    }
+
+    // 随机安全策略：相邻有食物就吃，否则在不会立即撞上的方向里随机选一个，没有时返回 stop
+    // 蒙特卡洛树搜索的模拟和竞技场基准里的电脑蛇都用它
+    static Direction randomSafeTurn(const GameMap& map, const Snake& s, Rng& rng);
+};
@@ -0,0 +1,239 @@
+#include "arena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+
+// 竞技场里每条蛇初始预留的蛇身容量，装满时翻倍
+const int initialBodyCapacity = 64;
+
+}
+
+Arena::Arena(int width, int height)
+    : gameMap(width, height), foodManager(width, height), version(expert), tickCount(0),
+    ended(true), humans(0), alive(0), claimAt(width * height, -1), headAt(width * height, -1) {
+}
+
+void Arena::init(int snakeCount, GameVersion version_, uint64_t seed, int humans_) {
+    version = version_;
+    rng.reseed(seed);
+    tickCount = 0;
+    ended = false;
+    humans = min(max(humans_, 0), min(snakeCount, 2));
+
+    gameMap.reset();
+    wallManager.reset(gameMap);
+
+    // 入门版1条命，进阶版满命直到剩余空间不足，高级版5条命
+    int lives = (version == beginner) ? 1 : (version == advanced) ? gameMap.getCellCount() : 5;
+    // 沿用上一局的蛇对象，蛇身缓冲区已经扩到的容量留给这一局，不再每局重新分配
+    if (static_cast<int>(snakes.size()) > snakeCount) {
+        snakes.erase(snakes.begin() + snakeCount, snakes.end());
+    }
+    snakes.reserve(snakeCount);
+    while (static_cast<int>(snakes.size()) < snakeCount) {
+        snakes.emplace_back(static_cast<int>(snakes.size()) + 1, initialBodyCapacity);
+    }
+    clock.resize(snakeCount);
+    for (int i = 0; i < snakeCount; ++i) {
+        // 键盘控制的蛇和双人模式一样原地等待第一次按键，电脑控制的蛇随机选初始方向
+        bool placed = (i < humans) ? snakes[i].reset(gameMap, rng, lives, stop) : snakes[i].reset(gameMap, rng, lives);
+        if (!placed) {
+            ended = true;
+        }
+        clock.restart(i, placed);
+    }
+    alive = snakeCount;
+    scores.assign(snakeCount, 0);
+    newHead.assign(snakeCount, -1);
+    fate.assign(snakeCount, idle);
+    involved.clear();
+    involved.reserve(snakeCount);
+    fill(headAt.begin(), headAt.end(), -1);
+    for (int i = 0; i < snakeCount; ++i) {
+        setHead(i, i);
+    }
+
+    foodManager.reset();
+    if (!replenishFood()) {
+        ended = true;
+    }
+}
+
+void Arena::setHead(int i, int value) {
+    if (!snakes[i].getBody().empty()) {
+        auto h = snakes[i].getHeadPos();
+        headAt[gameMap.index(h.first, h.second)] = value;
+    }
+}
+
+void Arena::drainKeys(Snake& snake, InputSource& keys, keyStatus keyType) {
+    // 每个 getKey 只返回一次按键；设个上限，防止输入源一直有键
+    for (int i = 0; i < 4 * maxTurnQueueDepth; ++i) {
+        auto key = keys.getKey(keyType);
+        if (key.second == none) {
+            return;
+        }
+        snake.queueTurn(key);
+    }
+}
+
+bool Arena::replenishFood() {
+    size_t wanted = static_cast<size_t>(max(alive, 1));
+    while (foodManager.getFoodList().size() < wanted) {
+        if (!foodManager.generateFood(gameMap, rng)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Arena::update(ArenaInput& bots, InputSource* keys) {
+    if (ended) {
+        return;
+    }
+
+    ++tickCount;
+
+    // 上一帧参与判定的蛇恢复为不动，其余的蛇本来就是
+    for (int i : involved) {
+        newHead[i] = -1;
+        fate[i] = idle;
+    }
+    involved.clear();
+
+    // 1. 取出这一帧移动的蛇（键盘控制的蛇每帧都读按键），转向并计算新蛇头
+    for (int i = 0; i < humans && keys; ++i) {
+        drainKeys(snakes[i], *keys, (i == 0) ? p1 : p2);
+    }
+    clock.tick(tickCount - 1);
+    const vector<int>& movers = clock.getMovers();
+    for (int i : movers) {
+        Snake& s = snakes[i];
+        involved.push_back(i);
+        if (i >= humans) {
+            Direction d = bots.getTurn(*this, i);
+            if (d != stop) {
+                s.queueDirection(d);
+            }
+        }
+        s.applyQueuedTurn();
+        auto pos = s.findNewHead();
+        // 还没有方向的蛇原地不动
+        if (pos == s.getHeadPos()) {
+            continue;
+        }
+        fate[i] = moved;
+        newHead[i] = gameMap.inBounds(pos.first, pos.second) ? gameMap.index(pos.first, pos.second) : -1;
+    }
+
+    // 2. 移动的蛇认领新蛇头（蛇头登记表随蛇移动与重生更新）：同一格被认领两次，
+    //    或认领到别的蛇的蛇头，都算蛇头相撞，被撞的蛇不移动也要一起判定
+    //    先让所有移动的蛇认领完，再逐个检查，已判为相撞的蛇照样认领，结果与编号顺序无关
+    for (int i : movers) {
+        if (fate[i] != moved) {
+            continue;
+        }
+        int c = newHead[i];
+        if (c < 0) {
+            fate[i] = crashed;
+            continue;
+        }
+        int other = claimAt[c];
+        if (other >= 0) {
+            fate[i] = headOn;
+            fate[other] = headOn;
+        }
+        else {
+            claimAt[c] = i;
+        }
+    }
+    for (int i : movers) {
+        int c = newHead[i];
+        if (c < 0) {
+            continue;
+        }
+        int h = headAt[c];
+        if (h >= 0) {
+            fate[i] = headOn;
+            // 不移动的蛇只在第一次被撞时加入判定
+            if (!clock.isMoving(h) && fate[h] == idle) {
+                involved.push_back(h);
+            }
+            fate[h] = headOn;
+        }
+    }
+    for (int i : movers) {
+        if (newHead[i] >= 0) {
+            claimAt[newHead[i]] = -1;
+        }
+    }
+    // 死亡按编号处理，重生位置与逐条处理的顺序无关
+    sort(involved.begin(), involved.end());
+
+    // 3. 撞墙、撞蛇身（按帧开始时的地图，只有自己的蛇尾会让开）
+    for (int i : movers) {
+        if (fate[i] == moved && snakes[i].checkCollision(gameMap, gameMap.position(newHead[i]))) {
+            fate[i] = crashed;
+        }
+    }
+
+    // 4. 活下来的蛇移动
+    for (int i : movers) {
+        if (fate[i] == moved) {
+            setHead(i, -1);
+            snakes[i].move(gameMap);
+            setHead(i, i);
+        }
+    }
+
+    // 5. 死亡的蛇：尸体变墙或食物，然后重生
+    for (int i : involved) {
+        if (fate[i] != crashed && fate[i] != headOn) {
+            continue;
+        }
+        Snake& s = snakes[i];
+        setHead(i, -1);
+        if (version == advanced) {
+            wallManager.addWall(gameMap, s.getBody());
+        }
+        else {
+            foodManager.addFood(gameMap, rng, s.getBody());
+        }
+        bool hadLife = s.getLife() > 0;
+        if (!s.reset(gameMap, rng, s.getLife() - 1)) {
+            ended = true;
+        }
+        if (hadLife && s.getLife() <= 0) {
+            --alive;
+        }
+        setHead(i, i);
+        clock.restart(i, s.getLife() > 0 && !s.getBody().empty());
+    }
+
+    // 6. 吃到食物计分，加速状态下食物得分翻倍
+    for (int i : movers) {
+        Snake& s = snakes[i];
+        if (fate[i] != moved || !s.isEatState()) {
+            continue;
+        }
+        auto pos = gameMap.position(newHead[i]);
+        int tempScore = foodManager.getScore(pos);
+        if (tempScore == 5) {
+            clock.setSpeedUp(i);
+        }
+        scores[i] += tempScore * (clock.isSpeedUp(i) ? 2 : 1);
+        foodManager.removeFood(pos);
+        s.resetEat();
+    }
+
+    // 7. 只剩一条（单蛇竞技场为没有）还有生命的蛇时结束
+    if (alive <= (getSnakeCount() > 1 ? 1 : 0)) {
+        ended = true;
+    }
+    if (!replenishFood()) {
+        ended = true;
+    }
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "config.h"
+#include "food.h"
+#include "gamemap.h"
+#include "move_clock.h"
+#include "rng.h"
+#include "simulation.h"
+#include "snake.h"
+#include "wall.h"
+
+class Arena;
+
+// 竞技场里电脑控制的蛇的输入：每条蛇移动的那一帧询问一次
+class ArenaInput {
+public:
+    virtual ~ArenaInput() = default;
+
+    // 第 index 条蛇这一帧要移动，返回它的新方向，stop 表示保持当前方向
+    virtual Direction getTurn(const Arena& arena, int index) = 0;
+};
+
+// 多蛇竞技场：任意条蛇存放在一个连续数组里，规则与双人模式相同
+// （撞墙、撞蛇身死亡，蛇头相撞双方都死；进阶版尸体变墙，其余版本尸体变食物）
+// 碰撞判定一遍完成：所有蛇头登记在格子表里，每帧让移动的蛇认领新蛇头所在的格子，
+// 同一格被认领两次、或认领到别的蛇的蛇头就是蛇头相撞，不做两两比较
+// 每帧只处理 MoveClock 取出的移动的蛇（以及被它们撞到蛇头的蛇），耗时与移动的蛇数成正比
+// 所有蛇都按帧开始时的地图判定，结果与数组中的先后顺序无关
+// 地图每格只有 4 位，蛇身仍只分 snake1Body（第一条蛇）和 snake2Body（其余的蛇）两种
+class Arena {
+public:
+    // 每帧每条蛇的判定结果
+    enum Fate : uint8_t { idle = 0, moved, crashed, headOn };
+
+private:
+    GameMap gameMap;
+    std::vector<Snake> snakes;
+    std::vector<int> scores;
+    // 所有蛇的移动节奏，下标与 snakes 相同
+    MoveClock clock;
+    FoodManager foodManager;
+    WallManager wallManager;
+
+    GameVersion version;
+    Rng rng;
+    long long tickCount;
+    bool ended;
+    // 前 humans 条蛇（最多两条）由键盘控制，按玩家1/玩家2 的键位
+    int humans;
+    // 还有生命的蛇数
+    int alive;
+
+    // 本帧每条蛇的新蛇头格子（不移动为 -1）与判定结果，以及本帧参与判定的蛇
+    std::vector<int> newHead;
+    std::vector<Fate> fate;
+    std::vector<int> involved;
+    // 格子表：把这一格认领为新蛇头的蛇（每帧只清理用过的格子）、当前蛇头在这一格的蛇，没有为 -1
+    std::vector<int> claimAt;
+    std::vector<int> headAt;
+
+    // 在蛇头登记表里把第 i 条蛇的蛇头格子设为 value
+    void setHead(int i, int value);
+    // 把这一帧的按键全部读出，排进蛇的转向队列
+    void drainKeys(Snake& snake, InputSource& keys, keyStatus keyType);
+    // 食物少于存活的蛇数时补充，地图已满返回 false
+    bool replenishFood();
+
+public:
+    Arena(int width = mapWidth, int height = mapHeight);
+
+    // 按蛇数、版本和随机种子开始新的一局，前 humans_ 条蛇由键盘控制
+    void init(int snakeCount, GameVersion version_, uint64_t seed = 1, int humans_ = 0);
+
+    // 推进一帧：电脑控制的蛇在移动的那一帧向 bots 询问方向，键盘控制的蛇每帧从 keys 读取按键
+    void update(ArenaInput& bots, InputSource* keys = nullptr);
+
+    int getSnakeCount() const {
+        return static_cast<int>(snakes.size());
+    }
+
+    const Snake& getSnake(int i) const {
+        return snakes[i];
+    }
+
+    int getScore(int i) const {
+        return scores[i];
+    }
+
+    int getAlive() const {
+        return alive;
+    }
+
+    // 上一帧第 i 条蛇的新蛇头格子与判定结果
+    int getNewHead(int i) const {
+        return newHead[i];
+    }
+
+    Fate getFate(int i) const {
+        return fate[i];
+    }
+
+    bool isMovingThisFrame(int i) const {
+        return clock.isMoving(i);
+    }
+
+    bool isSpeedUp(int i) const {
+        return clock.isSpeedUp(i);
+    }
+
+    bool isEnded() const {
+        return ended;
+    }
+
+    long long getTickCount() const {
+        return tickCount;
+    }
+
+    GameVersion getVersion() const {
+        return version;
+    }
+
+    const GameMap& getMap() const {
+        return gameMap;
+    }
+
+    const FoodManager& getFoodManager() const {
+        return foodManager;
+    }
+
+    const WallManager& getWallManager() const {
+        return wallManager;
+    }
+};
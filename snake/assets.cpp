@@ -0,0 +1,157 @@
+#include "assets.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <objidl.h>
+#include <gdiplus.h>
+#pragma comment(lib, "gdiplus.lib")
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+bool decodePng(const string& path, PixelImage& out) {
+    // GDI+ 只需启动一次，进程结束时由系统回收
+    static ULONG_PTR token = 0;
+    static Gdiplus::Status started = [] {
+        Gdiplus::GdiplusStartupInput input;
+        return Gdiplus::GdiplusStartup(&token, &input, NULL);
+    }();
+    if (started != Gdiplus::Ok) {
+        return false;
+    }
+
+    int length = MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, NULL, 0);
+    if (length <= 0) {
+        return false;
+    }
+    wstring widePath(length, L'\0');
+    MultiByteToWideChar(CP_ACP, 0, path.c_str(), -1, &widePath[0], length);
+
+    Gdiplus::Bitmap bitmap(widePath.c_str());
+    if (bitmap.GetLastStatus() != Gdiplus::Ok) {
+        return false;
+    }
+    int w = static_cast<int>(bitmap.GetWidth());
+    int h = static_cast<int>(bitmap.GetHeight());
+    out = PixelImage(w, h);
+
+    // 直接解码到 out 的像素数组，32bppARGB 在内存中正好是 0xAARRGGBB
+    Gdiplus::BitmapData data;
+    data.Width = w;
+    data.Height = h;
+    data.Stride = w * 4;
+    data.PixelFormat = PixelFormat32bppARGB;
+    data.Scan0 = out.pixels.data();
+    data.Reserved = 0;
+    Gdiplus::Rect rect(0, 0, w, h);
+    if (bitmap.LockBits(&rect, Gdiplus::ImageLockModeRead | Gdiplus::ImageLockModeUserInputBuf,
+        PixelFormat32bppARGB, &data) != Gdiplus::Ok) {
+        return false;
+    }
+    bitmap.UnlockBits(&data);
+    return true;
+}
+#else
+bool decodePng(const string&, PixelImage&) {
+    return false;
+}
+#endif
+
+AssetManager::AssetManager(int spriteSize_, uint32_t background_)
+    : spriteSize(spriteSize_), background(background_), loadMs(0) {
+}
+
+AssetHandle AssetManager::add(const string& file, AssetKind kind) {
+    Asset a;
+    a.file = file;
+    a.kind = kind;
+    a.loaded = false;
+    a.rect = AtlasRect{ 0, 0, 0, 0 };
+    assets.push_back(a);
+    return static_cast<AssetHandle>(assets.size() - 1);
+}
+
+int AssetManager::loadAll(const string& dir, ThreadPool& pool, const ImageDecoder& decoder) {
+    auto begin = chrono::steady_clock::now();
+
+    // 每个文件一个任务：解码、合成透明度、贴图缩放，互不共享数据
+    pool.parallelFor(static_cast<int>(assets.size()), 1, [&](int first, int last) {
+        for (int i = first; i < last; ++i) {
+            Asset& a = assets[i];
+            PixelImage decoded;
+            a.loaded = decoder(dir + "/" + a.file, decoded) && !decoded.empty();
+            if (!a.loaded) {
+                a.image = PixelImage();
+                continue;
+            }
+            compositeOver(decoded, background);
+            if (a.kind == assetSprite) {
+                a.image = scaleImage(decoded, spriteSize, spriteSize);
+            }
+            else {
+                a.image = move(decoded);
+            }
+        }
+    });
+
+    failed.clear();
+    for (const Asset& a : assets) {
+        if (!a.loaded) {
+            failed.push_back(a.file);
+        }
+    }
+    packAtlas();
+
+    loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count();
+    return static_cast<int>(failed.size());
+}
+
+void AssetManager::packAtlas() {
+    vector<int> order;
+    long long area = 0;
+    int widest = 0;
+    for (int i = 0; i < static_cast<int>(assets.size()); ++i) {
+        const Asset& a = assets[i];
+        if (a.kind == assetSprite && a.loaded) {
+            order.push_back(i);
+            area += static_cast<long long>(a.image.width) * a.image.height;
+            widest = max(widest, a.image.width);
+        }
+    }
+    if (order.empty()) {
+        atlas = PixelImage();
+        return;
+    }
+    sort(order.begin(), order.end(), [&](int l, int r) {
+        return assets[l].image.height > assets[r].image.height;
+    });
+
+    // 图集宽取不小于总面积平方根的 2 的幂，逐行（货架）摆放
+    int width = 1;
+    while (static_cast<long long>(width) * width < area || width < widest) {
+        width <<= 1;
+    }
+    int x = 0, y = 0, shelf = 0;
+    for (int i : order) {
+        Asset& a = assets[i];
+        if (x + a.image.width > width) {
+            x = 0;
+            y += shelf;
+            shelf = 0;
+        }
+        a.rect = AtlasRect{ x, y, a.image.width, a.image.height };
+        x += a.image.width;
+        shelf = max(shelf, a.image.height);
+    }
+
+    atlas = PixelImage(width, y + shelf, background);
+    for (int i : order) {
+        Asset& a = assets[i];
+        blitImage(atlas, a.image, a.rect.x, a.rect.y);
+        a.image = PixelImage();
+    }
+}
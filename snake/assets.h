@@ -0,0 +1,95 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "pixelimage.h"
+#include "thread_pool.h"
+
+// 资源句柄，即注册顺序的下标
+typedef int AssetHandle;
+const AssetHandle invalidAsset = -1;
+
+// 小贴图缩放到一格大小后打包进图集，背景图保持原尺寸单独存放
+enum AssetKind {
+    assetSprite,
+    assetBackground
+};
+
+// 贴图在图集中的位置
+struct AtlasRect {
+    int x, y, w, h;
+};
+
+// 读取一个图片文件，失败返回 false
+typedef std::function<bool(const std::string& path, PixelImage& out)> ImageDecoder;
+
+// 用系统的图片解码器读取 PNG（Windows 下为 GDI+），其他平台不支持，总是返回 false
+bool decodePng(const std::string& path, PixelImage& out);
+
+// 资源管理器：启动时一次性并行解码全部图片，贴图预缩放并打包成一张图集，各处通过句柄取用
+class AssetManager {
+private:
+    struct Asset {
+        std::string file;
+        AssetKind kind;
+        bool loaded;
+        // 背景图的像素；贴图打包后清空，只留图集中的位置
+        PixelImage image;
+        AtlasRect rect;
+    };
+
+    int spriteSize;
+    uint32_t background;
+    std::vector<Asset> assets;
+    PixelImage atlas;
+    std::vector<std::string> failed;
+    double loadMs;
+
+    // 按高度从高到低分层摆放贴图
+    void packAtlas();
+
+public:
+    // 贴图缩放到 spriteSize 见方，透明部分合成到 background 上（EasyX 贴图不处理透明度）
+    AssetManager(int spriteSize_ = gridSize, uint32_t background_ = 0xFFFFFF);
+
+    // 注册资源，需在 loadAll 之前调用
+    AssetHandle add(const std::string& file, AssetKind kind);
+
+    // 在线程池上并行解码所有已注册的资源并打包图集，返回加载失败的个数
+    int loadAll(const std::string& dir, ThreadPool& pool, const ImageDecoder& decoder = decodePng);
+
+    bool isLoaded(AssetHandle h) const {
+        return h >= 0 && h < static_cast<int>(assets.size()) && assets[h].loaded;
+    }
+
+    const std::string& getFile(AssetHandle h) const {
+        return assets[h].file;
+    }
+
+    // 贴图在图集中的位置
+    const AtlasRect& getRect(AssetHandle h) const {
+        return assets[h].rect;
+    }
+
+    // 背景图，加载失败时为空图
+    const PixelImage& getImage(AssetHandle h) const {
+        return assets[h].image;
+    }
+
+    const PixelImage& getAtlas() const {
+        return atlas;
+    }
+
+    // 加载失败的文件名
+    const std::vector<std::string>& getFailed() const {
+        return failed;
+    }
+
+    // 上次 loadAll 的耗时（毫秒）
+    double getLoadMs() const {
+        return loadMs;
+    }
+};
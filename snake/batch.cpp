@@ -0,0 +1,86 @@
+#include "batch.h"
+
+#include <chrono>
+
+using namespace std;
+
+BatchRunner::BatchRunner(int boardCount, GameState mode_, GameVersion version_,
+    uint64_t seed, int width, int height) : mode(mode_), version(version_) {
+    boards.reserve(boardCount);
+    for (int i = 0; i < boardCount; ++i) {
+        boards.emplace_back(width, height, seed + i);
+        Board& b = boards.back();
+        b.sim.init(mode, version, b.seeds.next64());
+    }
+}
+
+void BatchRunner::stepBoard(Board& b, int ticks) {
+    for (int t = 0; t < ticks; ++t) {
+        b.sim.update(b.input);
+        if (b.sim.isEnded()) {
+            ++b.games;
+            b.sim.init(mode, version, b.seeds.next64());
+        }
+    }
+    b.ticks += ticks;
+}
+
+BatchStats BatchRunner::runLockstep(ThreadPool& pool, int steps, int ticksPerStep) {
+    BatchStats before;
+    for (const auto& b : boards) {
+        before.ticks += b.ticks;
+        before.games += b.games;
+    }
+
+    // 每个任务负责若干块棋盘，保证任务数明显多于线程数以便窃取
+    int grain = size() / (pool.size() * 8);
+    if (grain < 1) {
+        grain = 1;
+    }
+
+    auto begin = chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        pool.parallelFor(size(), grain, [this, ticksPerStep](int from, int to) {
+            for (int i = from; i < to; ++i) {
+                stepBoard(boards[i], ticksPerStep);
+            }
+        });
+    }
+    auto end = chrono::steady_clock::now();
+
+    BatchStats stats;
+    for (const auto& b : boards) {
+        stats.ticks += b.ticks;
+        stats.games += b.games;
+    }
+    stats.ticks -= before.ticks;
+    stats.games -= before.games;
+    stats.seconds = chrono::duration<double>(end - begin).count();
+    return stats;
+}
+
+BatchStats BatchRunner::runIndependent(ThreadPool& pool, int gamesPerBoard) {
+    BatchStats stats;
+    vector<long long> ticks(boards.size(), 0);
+
+    auto begin = chrono::steady_clock::now();
+    // 每局长度差异很大，每块棋盘单独作为一个任务，由工作窃取负责均衡
+    pool.parallelFor(size(), 1, [this, gamesPerBoard, &ticks](int from, int to) {
+        for (int i = from; i < to; ++i) {
+            Board& b = boards[i];
+            long long target = b.games + gamesPerBoard;
+            while (b.games < target) {
+                stepBoard(b, 1);
+                ++ticks[i];
+            }
+        }
+    });
+    auto end = chrono::steady_clock::now();
+
+    for (size_t i = 0; i < boards.size(); ++i) {
+        stats.ticks += ticks[i];
+    }
+    stats.games = static_cast<long long>(gamesPerBoard) * size();
+    stats.seconds = chrono::duration<double>(end - begin).count();
+    return stats;
+}
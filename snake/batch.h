@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "config.h"
+#include "scripted_input.h"
+#include "simulation.h"
+#include "thread_pool.h"
+
+// 一批对局的统计结果
+struct BatchStats {
+    long long ticks;
+    long long games;
+    double seconds;
+
+    BatchStats() : ticks(0), games(0), seconds(0) {
+    }
+};
+
+// 批量模拟器：持有 N 个互相独立的对局（各自的地图、蛇、食物），在线程池上并行推进
+// 对局结束后立即在同一块棋盘上开始下一局
+class BatchRunner {
+private:
+    struct Board {
+        Simulation sim;
+        ScriptedInput input;
+        // 为这块棋盘上的每一局派生种子
+        Rng seeds;
+        long long ticks;
+        long long games;
+
+        Board(int width, int height, uint64_t seed)
+            : sim(width, height), input(seed), seeds(seed, 2), ticks(0), games(0) {
+        }
+    };
+
+    std::vector<Board> boards;
+    GameState mode;
+    GameVersion version;
+
+    // 推进一块棋盘 ticks 帧
+    void stepBoard(Board& b, int ticks);
+
+public:
+    BatchRunner(int boardCount, GameState mode_, GameVersion version_,
+        uint64_t seed = 1, int width = mapWidth, int height = mapHeight);
+
+    int size() const {
+        return static_cast<int>(boards.size());
+    }
+
+    // 锁步推进：共 steps 轮，每轮所有棋盘各推进 ticksPerStep 帧，轮与轮之间同步
+    BatchStats runLockstep(ThreadPool& pool, int steps, int ticksPerStep);
+
+    // 独立推进：每块棋盘各自跑完 gamesPerBoard 局，互不等待
+    BatchStats runIndependent(ThreadPool& pool, int gamesPerBoard);
+};
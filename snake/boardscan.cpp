@@ -0,0 +1,252 @@
+#include "boardscan.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SNAKE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要给 AVX2 函数单独打开指令集，MSVC 不需要
+#if defined(SNAKE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace {
+
+// 不依赖 POPCNT 指令的位计数
+inline int popcount32(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return static_cast<int>((x * 0x01010101u) >> 24);
+}
+
+inline int lowestBit(uint32_t x) {
+    int i = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+// 把 16 位掩码的每一位隔一位摊开，低 4 位与高 4 位的掩码交错后恢复格子顺序
+inline uint32_t spreadBits(uint32_t x) {
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+    return x;
+}
+
+// 在位图 bits 中找第 n 个 1
+inline int selectBit(uint32_t bits, int n) {
+    for (int i = 0; i < n; ++i) {
+        bits &= bits - 1;
+    }
+    return lowestBit(bits);
+}
+
+inline uint8_t cellAt(const uint8_t* packed, int cell) {
+    return (packed[cell >> 1] >> ((cell & 1) << 2)) & 0xF;
+}
+
+// ---------- 标量版本 ----------
+
+int countScalar(const uint8_t* packed, int cells, uint8_t e) {
+    int result = 0;
+    for (int c = 0; c < cells; ++c) {
+        result += cellAt(packed, c) == e;
+    }
+    return result;
+}
+
+int findNthScalar(const uint8_t* packed, int cells, uint8_t e, int n) {
+    for (int c = 0; c < cells; ++c) {
+        if (cellAt(packed, c) == e && n-- == 0) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+// 填充直接用 memset，C 库里的 memset 已经按 CPU 选用了最宽的向量指令，手写的 SIMD 循环反而更慢
+void fillScalar(uint8_t* packed, int cells, uint8_t e) {
+    memset(packed, e | (e << 4), cells / 2);
+    if (cells & 1) {
+        uint8_t& last = packed[cells / 2];
+        last = static_cast<uint8_t>((last & 0xF0) | e);
+    }
+}
+
+// 处理完整字节之后剩下的奇数格
+int countTail(const uint8_t* packed, int from, int cells, uint8_t e) {
+    int result = 0;
+    for (int c = from; c < cells; ++c) {
+        result += cellAt(packed, c) == e;
+    }
+    return result;
+}
+
+int findTail(const uint8_t* packed, int from, int cells, uint8_t e, int n) {
+    for (int c = from; c < cells; ++c) {
+        if (cellAt(packed, c) == e && n-- == 0) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+#ifdef SNAKE_X86
+
+// ---------- SSE2 版本：每次 16 字节即 32 格 ----------
+
+// 16 字节中低/高 4 位等于 e 的掩码
+inline void matchSse2(const uint8_t* p, __m128i target, __m128i nibble, uint32_t& lo, uint32_t& hi) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    __m128i low = _mm_and_si128(v, nibble);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+    lo = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(low, target)));
+    hi = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(high, target)));
+}
+
+int countSse2(const uint8_t* packed, int cells, uint8_t e) {
+    const __m128i target = _mm_set1_epi8(static_cast<char>(e));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    int bytes = cells / 2;
+    int result = 0;
+    int b = 0;
+    for (; b + 16 <= bytes; b += 16) {
+        uint32_t lo, hi;
+        matchSse2(packed + b, target, nibble, lo, hi);
+        result += popcount32(lo) + popcount32(hi);
+    }
+    return result + countTail(packed, b * 2, cells, e);
+}
+
+int findNthSse2(const uint8_t* packed, int cells, uint8_t e, int n) {
+    const __m128i target = _mm_set1_epi8(static_cast<char>(e));
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    int bytes = cells / 2;
+    int b = 0;
+    for (; b + 16 <= bytes; b += 16) {
+        uint32_t lo, hi;
+        matchSse2(packed + b, target, nibble, lo, hi);
+        int found = popcount32(lo) + popcount32(hi);
+        if (n < found) {
+            return b * 2 + selectBit(spreadBits(lo) | (spreadBits(hi) << 1), n);
+        }
+        n -= found;
+    }
+    return findTail(packed, b * 2, cells, e, n);
+}
+
+// ---------- AVX2 版本：每次 32 字节即 64 格 ----------
+
+TARGET_AVX2 inline void matchAvx2(const uint8_t* p, __m256i target, __m256i nibble, uint32_t& lo, uint32_t& hi) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i low = _mm256_and_si256(v, nibble);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    lo = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, target)));
+    hi = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, target)));
+}
+
+TARGET_AVX2 int countAvx2(const uint8_t* packed, int cells, uint8_t e) {
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(e));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    int bytes = cells / 2;
+    int result = 0;
+    int b = 0;
+    for (; b + 32 <= bytes; b += 32) {
+        uint32_t lo, hi;
+        matchAvx2(packed + b, target, nibble, lo, hi);
+        result += popcount32(lo) + popcount32(hi);
+    }
+    return result + countSse2(packed + b, cells - b * 2, e);
+}
+
+TARGET_AVX2 int findNthAvx2(const uint8_t* packed, int cells, uint8_t e, int n) {
+    const __m256i target = _mm256_set1_epi8(static_cast<char>(e));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    int bytes = cells / 2;
+    int b = 0;
+    for (; b + 32 <= bytes; b += 32) {
+        uint32_t lo, hi;
+        matchAvx2(packed + b, target, nibble, lo, hi);
+        int found = popcount32(lo) + popcount32(hi);
+        if (n < found) {
+            // 先看前 16 字节，再看后 16 字节
+            uint32_t first = spreadBits(lo & 0xFFFF) | (spreadBits(hi & 0xFFFF) << 1);
+            int inFirst = popcount32(first);
+            if (n < inFirst) {
+                return b * 2 + selectBit(first, n);
+            }
+            uint32_t second = spreadBits(lo >> 16) | (spreadBits(hi >> 16) << 1);
+            return b * 2 + 32 + selectBit(second, n - inFirst);
+        }
+        n -= found;
+    }
+    int rest = findNthSse2(packed + b, cells - b * 2, e, n);
+    return rest < 0 ? -1 : b * 2 + rest;
+}
+
+bool cpuHasAvx2() {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    // 需要 OSXSAVE 且操作系统保存了 YMM 寄存器
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+} // namespace
+
+const BoardKernels& scalarKernels() {
+    static const BoardKernels kernels = { "scalar", countScalar, findNthScalar, fillScalar };
+    return kernels;
+}
+
+const BoardKernels* sse2Kernels() {
+#ifdef SNAKE_X86
+    // x86 目标都按支持 SSE2 编译（x86-64 必然支持）
+    static const BoardKernels kernels = { "sse2", countSse2, findNthSse2, fillScalar };
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+const BoardKernels* avx2Kernels() {
+#ifdef SNAKE_X86
+    static const BoardKernels kernels = { "avx2", countAvx2, findNthAvx2, fillScalar };
+    static const bool supported = cpuHasAvx2();
+    return supported ? &kernels : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+const BoardKernels& boardKernels() {
+    static const BoardKernels& best = avx2Kernels() ? *avx2Kernels()
+        : sse2Kernels() ? *sse2Kernels() : scalarKernels();
+    return best;
+}
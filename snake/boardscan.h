@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// 整张地图的扫描内核，作用于 GameMap 的 4 位紧凑存储（格子 i 在第 i / 2 字节，偶数格在低 4 位）
+// 有标量、SSE2、AVX2 三个版本，启动时按 CPU 支持情况选用最快的一个
+struct BoardKernels {
+    const char* name;
+    // 前 cells 个格子中元素 e 的个数（即 e 在 cells 处的秩）
+    int (*count)(const uint8_t* packed, int cells, uint8_t e);
+    // 前 cells 个格子中第 n 个（从 0 开始）元素 e 的格子编号，不足 n + 1 个返回 -1
+    int (*findNth)(const uint8_t* packed, int cells, uint8_t e, int n);
+    // 把前 cells 个格子全部设为 e
+    void (*fill)(uint8_t* packed, int cells, uint8_t e);
+};
+
+const BoardKernels& scalarKernels();
+// CPU 不支持时返回 nullptr
+const BoardKernels* sse2Kernels();
+const BoardKernels* avx2Kernels();
+
+// 当前 CPU 上最快的一组内核
+const BoardKernels& boardKernels();
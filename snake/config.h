@@ -0,0 +1,39 @@
+#pragma once
+
+// --- 全局常量定义 ---
+
+const int windowWidth = 1440; // 增大窗口宽度
+const int windowHeight = 720; // 增大窗口高度
+const int gridSize = 40;      // 增大网格大小
+const int mapWidth = (windowWidth - 240) / gridSize;
+const int mapHeight = (windowHeight) / gridSize; // 预留UI区域
+
+// 每个逻辑帧（tick）的时长，单位毫秒
+const int frameInterval = 10;
+
+
+// --- 枚举类型定义 ---
+enum Direction { stop = 0, up, down, left_dir, right_dir };
+enum GameState { menu = 0, singleMode, pairMode, viewRecords, gameOver };
+enum MapElement { emptyInfo = 0, food, snake1Body, snake2Body, wall };
+enum GameVersion { selecting = 0, beginner, advanced, expert };
+enum keyStatus { none = 0, p1, p2, func };
+
+
+// 方向键虚拟键码，非 Windows 平台下没有 windows.h，这里补齐（数值与 Windows 一致）
+#ifndef VK_LEFT
+#define VK_LEFT  0x25
+#define VK_UP    0x26
+#define VK_RIGHT 0x27
+#define VK_DOWN  0x28
+#endif
+
+// 每条蛇最多预存的转向数，两次移动之间快速按下的连续转向会依次生效
+const int turnQueueDepth = 3;
+// 转向队列深度的上限
+const int maxTurnQueueDepth = 8;
+
+// 渲染间隔（毫秒），约 60 帧每秒，与逻辑帧率无关
+const int renderInterval = 16;
+// 渲染跟不上时，单个渲染帧内最多追赶的逻辑帧数
+const int maxTicksPerFrame = 10;
@@ -0,0 +1,64 @@
+#include "food.h"
+
+using namespace std;
+
+void FoodManager::reset() {
+    for (const auto& f : foodList) {
+        slotAt[f.y * width + f.x] = -1;
+    }
+    foodList.clear();
+}
+
+void FoodManager::placeFood(GameMap& map, int x, int y, int ID) {
+    int cell = y * width + x;
+    // 两蛇头相撞时同一格会出现在两条蛇身上，只保留先放下的食物
+    if (slotAt[cell] == -1) {
+        slotAt[cell] = static_cast<int>(foodList.size());
+        foodList.push_back(Food(x, y, ID));
+    }
+    map.set(x, y, food);
+}
+
+bool FoodManager::generateFood(GameMap& map, Rng& rng) {
+    int i = rng.below(5) + 1;
+    for (int j = 0; j < i; ++j) {
+        auto pos = map.getRandomEmptyPosition(rng);
+        if (pos.first != -1) {
+            placeFood(map, pos.first, pos.second, rng.below(5));
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FoodManager::addFood(GameMap& map, Rng& rng, const SnakeBody& body) {
+    SnakeBody::Span spans[2];
+    int n = body.segments(spans);
+    for (int s = 0; s < n; ++s) {
+        for (size_t i = 0; i < spans[s].size; ++i) {
+            auto pos = unpackPos(spans[s].data[i]);
+            placeFood(map, pos.first, pos.second, rng.below(5));
+        }
+    }
+}
+
+void FoodManager::removeFood(pair<int, int> pos) {
+    int cell = pos.second * width + pos.first;
+    int slot = slotAt[cell];
+    if (slot == -1) {
+        return;
+    }
+    // 用末尾的食物填补空位
+    Food& last = foodList.back();
+    slotAt[last.y * width + last.x] = slot;
+    foodList[slot] = last;
+    foodList.pop_back();
+    slotAt[cell] = -1;
+}
+
+int FoodManager::getScore(pair<int, int> pos) const {
+    int slot = slotAt[pos.second * width + pos.first];
+    return (slot == -1) ? 0 : foodList[slot].foodScore;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "gamemap.h"
+#include "rng.h"
+#include "snakebody.h"
+
+// 食物结构体
+struct Food {
+    int x, y;
+    int ID;
+    int foodScore;
+    Food(int x_, int y_, int ID_) : x(x_), y(y_), ID(ID_) {
+        // 根据ID设置食物分数
+        foodScore = ID + 1;
+    }
+};
+
+// 食物管理器类（只包含游戏逻辑，贴图由界面层负责）
+// 食物按格子建立索引（格子 -> foodList 下标），查找与删除都是 O(1)
+class FoodManager {
+private:
+    // 地图宽度，用于把坐标换算成格子编号
+    int width;
+
+    // 食物列表，顺序无意义，删除时用末尾元素填补
+    std::vector<Food> foodList;
+    // 每个格子上食物在 foodList 中的下标，没有食物为 -1
+    std::vector<int> slotAt;
+
+    // 在指定位置放置一个食物
+    void placeFood(GameMap& map, int x, int y, int ID);
+
+public:
+    FoodManager(int width_ = mapWidth, int height_ = mapHeight)
+        : width(width_), slotAt(width_ * height_, -1) {
+        // 一个格子最多一个食物，预留满容量避免游戏中扩容
+        foodList.reserve(width_ * height_);
+    }
+
+    // 重置食物列表
+    void reset();
+
+    // 生成1~5个食物，返回是否生成成功
+    // 该bool返回值主要用于检测地图是否已满，也就是模式的是否结束
+    bool generateFood(GameMap& map, Rng& rng);
+
+    // 将蛇的尸体变为食物
+    void addFood(GameMap& map, Rng& rng, const SnakeBody& body);
+
+    // 移除指定位置的食物
+    void removeFood(std::pair<int, int> pos);
+
+    // 检查食物列表是否为空
+    bool foodEmpty() const {
+        return foodList.empty();
+    }
+
+    // 获取指定位置食物的分数
+    int getScore(std::pair<int, int> pos) const;
+
+    // 获取全部食物，供绘制使用
+    const std::vector<Food>& getFoodList() const {
+        return foodList;
+    }
+};
@@ -0,0 +1,76 @@
+#include "framebuffer.h"
+
+#include <algorithm>
+
+using namespace std;
+
+Framebuffer::Framebuffer(int width, int height)
+    : image(width, height, colorBackground), sprites(spriteCount), pixelsWritten(0) {
+}
+
+void Framebuffer::setSprite(int sprite, const PixelImage& img) {
+    if (sprite >= 0 && sprite < static_cast<int>(sprites.size())) {
+        sprites[sprite] = img;
+    }
+}
+
+void Framebuffer::clear(uint32_t color) {
+    fill(image.pixels.begin(), image.pixels.end(), color);
+    pixelsWritten += static_cast<long long>(image.pixels.size());
+}
+
+void Framebuffer::fillRect(int x, int y, int w, int h, uint32_t color) {
+    // 裁剪到画布内
+    int x0 = max(x, 0), y0 = max(y, 0);
+    int x1 = min(x + w, image.width), y1 = min(y + h, image.height);
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    for (int row = y0; row < y1; ++row) {
+        uint32_t* line = &image.pixels[static_cast<size_t>(row) * image.width];
+        fill(line + x0, line + x1, color);
+    }
+    pixelsWritten += static_cast<long long>(x1 - x0) * (y1 - y0);
+}
+
+void Framebuffer::fillCircle(int cx, int cy, int r, uint32_t color) {
+    // 逐行求出圆内的区间
+    for (int dy = -r; dy <= r; ++dy) {
+        int row = cy + dy;
+        if (row < 0 || row >= image.height) {
+            continue;
+        }
+        int dx = 0;
+        while ((dx + 1) * (dx + 1) + dy * dy <= r * r) {
+            ++dx;
+        }
+        int x0 = max(cx - dx, 0), x1 = min(cx + dx + 1, image.width);
+        if (x0 < x1) {
+            uint32_t* line = &image.pixels[static_cast<size_t>(row) * image.width];
+            fill(line + x0, line + x1, color);
+            pixelsWritten += x1 - x0;
+        }
+    }
+}
+
+bool Framebuffer::drawSprite(int x, int y, int sprite) {
+    if (!hasSprite(sprite)) {
+        return false;
+    }
+    const PixelImage& img = sprites[sprite];
+    int x0 = max(x, 0), y0 = max(y, 0);
+    int x1 = min(x + img.width, image.width), y1 = min(y + img.height, image.height);
+    for (int row = y0; row < y1; ++row) {
+        const uint32_t* src = &img.pixels[static_cast<size_t>(row - y) * img.width + (x0 - x)];
+        uint32_t* dst = &image.pixels[static_cast<size_t>(row) * image.width];
+        copy(src, src + (x1 - x0), dst + x0);
+    }
+    if (x0 < x1 && y0 < y1) {
+        pixelsWritten += static_cast<long long>(x1 - x0) * (y1 - y0);
+    }
+    return true;
+}
+
+bool Framebuffer::hasSprite(int sprite) const {
+    return sprite >= 0 && sprite < static_cast<int>(sprites.size()) && !sprites[sprite].pixels.empty();
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "pixelimage.h"
+#include "renderer.h"
+
+// 软件帧缓冲：在内存里完成全部绘制，用于在没有图形界面的环境下测量每帧的像素工作量
+class Framebuffer : public RenderTarget {
+private:
+    PixelImage image;
+    std::vector<PixelImage> sprites;
+    // 累计写入的像素数
+    long long pixelsWritten;
+
+public:
+    Framebuffer(int width, int height);
+
+    // 设置贴图，空图视为缺失
+    void setSprite(int sprite, const PixelImage& img);
+
+    void clear(uint32_t color);
+
+    void fillRect(int x, int y, int w, int h, uint32_t color) override;
+    void fillCircle(int cx, int cy, int r, uint32_t color) override;
+    bool drawSprite(int x, int y, int sprite) override;
+    bool hasSprite(int sprite) const override;
+
+    const PixelImage& getImage() const {
+        return image;
+    }
+
+    long long getPixelsWritten() const {
+        return pixelsWritten;
+    }
+
+    void resetPixelsWritten() {
+        pixelsWritten = 0;
+    }
+};
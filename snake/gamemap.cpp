@@ -0,0 +1,74 @@
+#include "gamemap.h"
+
+#include "boardscan.h"
+
+using namespace std;
+
+GameMap::GameMap(int width_, int height_)
+    : width(width_), height(height_),
+    packed((width_ * height_ + 1) / 2), freeCells(width_ * height_), freeSlot(width_ * height_), freeCount(0),
+    trackDirty(false), allDirty(true) {
+    reset();
+}
+
+void GameMap::reset() {
+    int cellCount = getCellCount();
+    boardKernels().fill(packed.data(), cellCount, emptyInfo);
+    for (int c = 0; c < cellCount; ++c) {
+        freeCells[c] = c;
+        freeSlot[c] = c;
+    }
+    freeCount = cellCount;
+    // 整张图都变了，逐格记录没有意义
+    clearDirty();
+    allDirty = true;
+}
+
+void GameMap::setDirtyTracking(bool on) {
+    trackDirty = on;
+    dirtyFlag.assign(on ? getCellCount() : 0, 0);
+    dirtyCells.clear();
+    // 每格最多记录一次
+    dirtyCells.reserve(on ? getCellCount() : 0);
+    allDirty = true;
+}
+
+void GameMap::clearDirty() {
+    for (int cell : dirtyCells) {
+        dirtyFlag[cell] = 0;
+    }
+    dirtyCells.clear();
+    allDirty = false;
+}
+
+void GameMap::addFree(int cell) {
+    freeCells[freeCount] = cell;
+    freeSlot[cell] = freeCount;
+    ++freeCount;
+}
+
+void GameMap::removeFree(int cell) {
+    // 用最后一个空格填补被移除的位置
+    int slot = freeSlot[cell];
+    int last = freeCells[--freeCount];
+    freeCells[slot] = last;
+    freeSlot[last] = slot;
+    freeSlot[cell] = -1;
+}
+
+int GameMap::count(MapElement e) const {
+    return boardKernels().count(packed.data(), getCellCount(), static_cast<uint8_t>(e));
+}
+
+pair<int, int> GameMap::findNth(MapElement e, int n) const {
+    int cell = boardKernels().findNth(packed.data(), getCellCount(), static_cast<uint8_t>(e), n);
+    return cell < 0 ? make_pair(-1, -1) : position(cell);
+}
+
+pair<int, int> GameMap::getRandomEmptyPosition(Rng& rng) const {
+    if (freeCount == 0) {
+        return make_pair(-1, -1); // 无空位置
+    }
+
+    return position(freeCells[rng.below(freeCount)]);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "rng.h"
+
+// 地图状态，记录每个格子上的元素
+// 每个格子占 4 位，按行优先两格一个字节紧凑存放，尺寸在运行时指定
+// 同时维护空格索引（空格紧凑数组 + 格子到数组下标的映射），随机取空位为 O(1)
+class GameMap {
+private:
+    int width, height;
+
+    // 紧凑存储的格子，格子 i 位于第 i / 2 个字节，偶数格在低 4 位
+    std::vector<uint8_t> packed;
+
+    // 所有空格的编号（y * width + x），前 freeCount 个有效
+    std::vector<int> freeCells;
+    // 每个格子在 freeCells 中的下标，非空格为 -1
+    std::vector<int> freeSlot;
+    int freeCount;
+
+    // 变化格子记录，供增量渲染只重绘改变的格子；默认关闭，批量模拟不需要
+    bool trackDirty;
+    // 上次清除以来整张地图都需要重绘（重置之后）
+    bool allDirty;
+    std::vector<int> dirtyCells;
+    std::vector<uint8_t> dirtyFlag;
+
+    // 把格子加入/移出空格索引
+    void addFree(int cell);
+    void removeFree(int cell);
+
+    void markDirty(int cell) {
+        if (!dirtyFlag[cell]) {
+            dirtyFlag[cell] = 1;
+            dirtyCells.push_back(cell);
+        }
+    }
+
+public:
+    GameMap(int width_ = mapWidth, int height_ = mapHeight);
+
+    // 初始化地图状态
+    void reset();
+
+    // 获取随机空位置，地图已满时返回 (-1, -1)
+    std::pair<int, int> getRandomEmptyPosition(Rng& rng) const;
+
+    int getWidth() const {
+        return width;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    int getCellCount() const {
+        return width * height;
+    }
+
+    // 剩余空格数
+    int getFreeCount() const {
+        return freeCount;
+    }
+
+    // 紧凑存储的原始字节，供扫描内核使用
+    const std::vector<uint8_t>& getPacked() const {
+        return packed;
+    }
+
+    // 整张图中元素 e 的个数（扫描整张图，平时用 getFreeCount 等 O(1) 的计数）
+    int count(MapElement e) const;
+    // 按格子顺序第 n 个（从 0 开始）元素 e 的位置，不存在返回 (-1, -1)
+    std::pair<int, int> findNth(MapElement e, int n) const;
+
+    // 坐标是否在地图内
+    bool inBounds(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+
+    // 坐标与格子编号互相转换（行优先）
+    int index(int x, int y) const {
+        return y * width + x;
+    }
+
+    std::pair<int, int> position(int cell) const {
+        return std::make_pair(cell % width, cell / width);
+    }
+
+    MapElement getCell(int cell) const {
+        return static_cast<MapElement>((packed[cell >> 1] >> ((cell & 1) << 2)) & 0xF);
+    }
+
+    MapElement get(int x, int y) const {
+        return getCell(index(x, y));
+    }
+
+    // 修改格子，所有对地图的写入都必须经过这里以保持空格索引一致
+    void setCell(int cell, MapElement e) {
+        MapElement old = getCell(cell);
+        if (old == e) {
+            return;
+        }
+        int shift = (cell & 1) << 2;
+        uint8_t& b = packed[cell >> 1];
+        b = static_cast<uint8_t>((b & ~(0xF << shift)) | (e << shift));
+        if (old == emptyInfo) {
+            removeFree(cell);
+        }
+        else if (e == emptyInfo) {
+            addFree(cell);
+        }
+        if (trackDirty) {
+            markDirty(cell);
+        }
+    }
+
+    void set(int x, int y, MapElement e) {
+        setCell(index(x, y), e);
+    }
+
+    // 开启/关闭变化格子记录
+    void setDirtyTracking(bool on);
+
+    bool isAllDirty() const {
+        return allDirty;
+    }
+
+    // 上次清除以来内容改变过的格子（不重复）
+    const std::vector<int>& getDirtyCells() const {
+        return dirtyCells;
+    }
+
+    // 渲染完成后清除变化记录
+    void clearDirty();
+
+    // 按行优先顺序遍历所有格子，f(x, y, element)
+    template <typename F>
+    void forEachCell(F&& f) const {
+        int cell = 0;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x, ++cell) {
+                f(x, y, getCell(cell));
+            }
+        }
+    }
+
+    // 遍历一行的所有格子，f(x, element)
+    template <typename F>
+    void forEachInRow(int y, F&& f) const {
+        int cell = index(0, y);
+        for (int x = 0; x < width; ++x, ++cell) {
+            f(x, getCell(cell));
+        }
+    }
+};
@@ -0,0 +1,177 @@
+#include "greedy_ai.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+// BFS 与连通区域检查每处理这么多格子检查一次是否超时
+const int budgetCheckMask = 255;
+
+}
+
+GreedyAI::GreedyAI(const Simulation& sim_, int player_, InputSource* others_, int budgetMicros_)
+    : AIInput(sim_, player_, others_), budgetMicros(budgetMicros_), currentStamp(0), overBudget(0) {
+    int cells = sim.getMap().getCellCount();
+    stamp.assign(cells, 0);
+    dist.assign(cells, 0);
+    firstMove.assign(cells, 0);
+    queue.assign(cells, 0);
+}
+
+uint32_t GreedyAI::nextStamp() {
+    // 印记用完一轮后整体清零，避免与旧印记混淆
+    if (++currentStamp == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        currentStamp = 1;
+    }
+    return currentStamp;
+}
+
+int GreedyAI::floodCount(const GameMap& map, int start, int tailCell, int limit,
+                         chrono::steady_clock::time_point deadline) {
+    int width = map.getWidth();
+    uint32_t s = nextStamp();
+    int qHead = 0, qTail = 0;
+    stamp[start] = s;
+    queue[qTail++] = start;
+    while (qHead < qTail && qTail < limit) {
+        int cell = queue[qHead++];
+        int x = cell % width, y = cell / width;
+        // 蛇很长时要数的格子很多，同样按预算中途放弃
+        if ((qHead & budgetCheckMask) == 0 && chrono::steady_clock::now() > deadline) {
+            return -1;
+        }
+        for (int d = up; d <= right_dir; ++d) {
+            int nx = x + dirX[d], ny = y + dirY[d];
+            if (!map.inBounds(nx, ny)) {
+                continue;
+            }
+            int next = map.index(nx, ny);
+            if (stamp[next] != s && passable(map, next, tailCell)) {
+                stamp[next] = s;
+                queue[qTail++] = next;
+            }
+        }
+    }
+    return qTail;
+}
+
+Direction GreedyAI::decide(const Snake& self, const Snake* rival) {
+    auto begin = chrono::steady_clock::now();
+    auto deadline = begin + chrono::microseconds(budgetMicros);
+    const GameMap& map = sim.getMap();
+    const FoodManager& foods = sim.getFoodManager();
+    int width = map.getWidth();
+
+    auto head = self.getHeadPos();
+    auto tail = self.getBody().back();
+    int tailCell = map.index(tail.first, tail.second);
+    int length = static_cast<int>(self.getBody().size());
+    Direction current = self.getDirection();
+
+    // 第一步可走的方向，并以它们为起点做多源 BFS，每个格子记下最短路径的第一步
+    bool candidate[5] = { false };
+    double bestValue[5] = { 0 };
+    uint32_t s = nextStamp();
+    int qHead = 0, qTail = 0;
+    stamp[map.index(head.first, head.second)] = s;
+    for (int d = up; d <= right_dir; ++d) {
+        int nx = head.first + dirX[d], ny = head.second + dirY[d];
+        if (d == oppositeDirection(current) || !map.inBounds(nx, ny)) {
+            continue;
+        }
+        int next = map.index(nx, ny);
+        if (passable(map, next, tailCell)) {
+            candidate[d] = true;
+            stamp[next] = s;
+            dist[next] = 1;
+            firstMove[next] = static_cast<int8_t>(d);
+            queue[qTail++] = next;
+        }
+    }
+
+    bool timeUp = false;
+    while (qHead < qTail) {
+        int cell = queue[qHead++];
+        int x = cell % width, y = cell / width;
+        int fm = firstMove[cell];
+        // 食物价值 = 分数 / 距离，每个第一步方向只保留最高的
+        if (map.getCell(cell) == food) {
+            double value = static_cast<double>(foods.getScore(make_pair(x, y))) / dist[cell];
+            if (value > bestValue[fm]) {
+                bestValue[fm] = value;
+            }
+        }
+        if ((qHead & budgetCheckMask) == 0
+            && chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count() > budgetMicros) {
+            timeUp = true;
+            break;
+        }
+        for (int d = up; d <= right_dir; ++d) {
+            int nx = x + dirX[d], ny = y + dirY[d];
+            if (!map.inBounds(nx, ny)) {
+                continue;
+            }
+            int next = map.index(nx, ny);
+            if (stamp[next] != s && passable(map, next, tailCell)) {
+                stamp[next] = s;
+                dist[next] = dist[cell] + 1;
+                firstMove[next] = static_cast<int8_t>(fm);
+                queue[qTail++] = next;
+            }
+        }
+    }
+    if (!timeUp) {
+        timeUp = chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count() > budgetMicros;
+    }
+
+    // 依次比较：能装下自己 > 不贴着对手蛇头 > 食物价值 > 剩余空间，当前方向优先参与比较以减少无谓转向
+    const Direction order[5] = { current, up, down, left_dir, right_dir };
+
+    Direction best = stop;
+    bool bestSafe = false, bestCalm = false;
+    double bestScore = 0;
+    int bestSpace = 0;
+    for (int i = 0; i < 5; ++i) {
+        Direction d = order[i];
+        if (d == stop || !candidate[d] || (i > 0 && d == current)) {
+            continue;
+        }
+        int nx = head.first + dirX[d], ny = head.second + dirY[d];
+        int space = timeUp ? length : floodCount(map, map.index(nx, ny), tailCell, length, deadline);
+        if (space < 0) {
+            // 检查到一半超时：已有比较过的方向就用它，否则不检查直接按能装下处理
+            timeUp = true;
+            if (best != stop) {
+                break;
+            }
+            space = length;
+        }
+        bool safe = space >= length;
+        bool calm = true;
+        if (rival && rival->getLife() > 0 && !rival->getBody().empty()) {
+            auto rh = rival->getHeadPos();
+            calm = abs(rh.first - nx) + abs(rh.second - ny) > 1;
+        }
+        double score = safe ? bestValue[d] : 0;
+        if (best == stop
+            || safe > bestSafe
+            || (safe == bestSafe && calm > bestCalm)
+            || (safe == bestSafe && calm == bestCalm && score > bestScore)
+            || (safe == bestSafe && calm == bestCalm && score == bestScore && space > bestSpace)) {
+            best = d;
+            bestSafe = safe;
+            bestCalm = calm;
+            bestScore = score;
+            bestSpace = space;
+        }
+    }
+    if (chrono::duration<double, micro>(chrono::steady_clock::now() - begin).count() > budgetMicros) {
+        ++overBudget;
+    }
+    return best;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "ai_input.h"
+
+// 贪心 AI：蛇每次移动前决定一次方向
+// 从蛇头 BFS 找 食物分数 / 距离 最高的食物，再对候选方向做连通区域检查，避免钻进装不下自己的死路
+// 所有搜索缓冲区在构造时按地图大小分配好，决策过程中不分配内存
+class GreedyAI : public AIInput {
+private:
+    // 每次决策的时间预算（微秒），BFS 或连通区域检查中途超时就不再检查剩下的方向
+    int budgetMicros;
+
+    // BFS 与连通区域检查共用的缓冲区：访问标记用递增的印记，免去每次清空
+    std::vector<uint32_t> stamp;
+    uint32_t currentStamp;
+    std::vector<int> dist;
+    std::vector<int8_t> firstMove;
+    std::vector<int> queue;
+
+    // 超出预算的决策次数
+    long long overBudget;
+
+    // 开始新一轮搜索，返回本轮的印记
+    uint32_t nextStamp();
+    // 从 start 出发的连通格子数，达到 limit 即停止；数到一半超过 deadline 返回 -1
+    int floodCount(const GameMap& map, int start, int tailCell, int limit,
+                   std::chrono::steady_clock::time_point deadline);
+
+public:
+    GreedyAI(const Simulation& sim_, int player_, InputSource* others_ = nullptr, int budgetMicros_ = 200);
+
+    long long getOverBudget() const {
+        return overBudget;
+    }
+
+    void resetStats() override {
+        AIInput::resetStats();
+        overBudget = 0;
+    }
+
+protected:
+    Direction decide(const Snake& self, const Snake* rival) override;
+};
@@ -0,0 +1,320 @@
+#include "hamilton_ai.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace {
+
+// 树边标记：向右、向下
+const uint8_t edgeEast = 1;
+const uint8_t edgeSouth = 2;
+
+}
+
+HamiltonAI::HamiltonAI(const Simulation& sim_, int player_, InputSource* others_)
+    : AIInput(sim_, player_, others_), cycleLength(0), wallsSeen(0), built(false), strictMoves(0), shortcuts(0) {
+    const GameMap& map = sim.getMap();
+    width = map.getWidth();
+    height = map.getHeight();
+    // 边框墙由 WallManager::reset 放在最外一圈
+    areaX = 1;
+    areaY = 1;
+    areaWidth = max(0, width - 2);
+    areaHeight = max(0, height - 2);
+    blocksX = areaWidth / 2;
+    blocksY = areaHeight / 2;
+
+    next.assign(width * height, -1);
+    order.assign(width * height, -1);
+    blockFree.assign(blocksX * blocksY, 0);
+    blockInTree.assign(blocksX * blocksY, 0);
+    blockEdges.assign(blocksX * blocksY, 0);
+    blockQueue.assign(blocksX * blocksY, 0);
+}
+
+void HamiltonAI::checkWalls() {
+    const auto& walls = sim.getWallManager().getWalls();
+    // 墙变少说明开始了新的一局
+    bool changed = !built || walls.size() < wallsSeen;
+    for (size_t i = wallsSeen; !changed && i < walls.size(); ++i) {
+        if (order[cellAt(walls[i].first, walls[i].second)] >= 0) {
+            changed = true;
+        }
+    }
+    wallsSeen = walls.size();
+    if (changed) {
+        const Snake& self = (player == 1) ? sim.getSnake1() : sim.getSnake2();
+        auto head = self.getHeadPos();
+        rebuild(sim.getMap().inBounds(head.first, head.second) ? cellAt(head.first, head.second) : -1);
+    }
+}
+
+void HamiltonAI::rebuild(int startCell) {
+    auto begin = chrono::steady_clock::now();
+    const GameMap& map = sim.getMap();
+    built = true;
+    strictMoves = 0;
+    cycleLength = 0;
+    fill(next.begin(), next.end(), -1);
+    fill(order.begin(), order.end(), -1);
+    if (blocksX == 0 || blocksY == 0) {
+        buildTime.add(elapsedMs(begin, chrono::steady_clock::now()));
+        return;
+    }
+
+    // 不含墙的块才能进入生成树
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            int x = areaX + 2 * bx, y = areaY + 2 * by;
+            int b = by * blocksX + bx;
+            blockFree[b] = map.get(x, y) != wall && map.get(x + 1, y) != wall
+                && map.get(x, y + 1) != wall && map.get(x + 1, y + 1) != wall;
+            blockInTree[b] = 0;
+            blockEdges[b] = 0;
+        }
+    }
+
+    // 生成树从蛇头所在的块开始，它不可用时取第一个可用的块
+    int root = -1;
+    if (startCell >= 0) {
+        int bx = min(max((startCell % width - areaX) / 2, 0), blocksX - 1);
+        int by = min(max((startCell / width - areaY) / 2, 0), blocksY - 1);
+        if (blockFree[by * blocksX + bx]) {
+            root = by * blocksX + bx;
+        }
+    }
+    for (int b = 0; root < 0 && b < blocksX * blocksY; ++b) {
+        if (blockFree[b]) {
+            root = b;
+        }
+    }
+    if (root < 0) {
+        buildTime.add(elapsedMs(begin, chrono::steady_clock::now()));
+        return;
+    }
+
+    int qHead = 0, qTail = 0;
+    blockInTree[root] = 1;
+    blockQueue[qTail++] = root;
+    while (qHead < qTail) {
+        int b = blockQueue[qHead++];
+        int bx = b % blocksX, by = b / blocksX;
+        // 树边记在左边/上边的块上
+        if (bx + 1 < blocksX && blockFree[b + 1] && !blockInTree[b + 1]) {
+            blockEdges[b] |= edgeEast;
+            blockInTree[b + 1] = 1;
+            blockQueue[qTail++] = b + 1;
+        }
+        if (bx > 0 && blockFree[b - 1] && !blockInTree[b - 1]) {
+            blockEdges[b - 1] |= edgeEast;
+            blockInTree[b - 1] = 1;
+            blockQueue[qTail++] = b - 1;
+        }
+        if (by + 1 < blocksY && blockFree[b + blocksX] && !blockInTree[b + blocksX]) {
+            blockEdges[b] |= edgeSouth;
+            blockInTree[b + blocksX] = 1;
+            blockQueue[qTail++] = b + blocksX;
+        }
+        if (by > 0 && blockFree[b - blocksX] && !blockInTree[b - blocksX]) {
+            blockEdges[b - blocksX] |= edgeSouth;
+            blockInTree[b - blocksX] = 1;
+            blockQueue[qTail++] = b - blocksX;
+        }
+    }
+
+    // 每个块内默认逆时针走一圈（左上 -> 左下 -> 右下 -> 右上），有树边的一侧改为走到相邻块
+    bool extraColumn = areaWidth % 2 == 1;
+    bool extraRow = areaHeight % 2 == 1;
+    int xEnd = areaX + areaWidth - 1, yEnd = areaY + areaHeight - 1;
+    for (int i = 0; i < qTail; ++i) {
+        int b = blockQueue[i];
+        int bx = b % blocksX, by = b / blocksX;
+        int x = areaX + 2 * bx, y = areaY + 2 * by;
+        int topLeft = cellAt(x, y), topRight = cellAt(x + 1, y);
+        int bottomLeft = cellAt(x, y + 1), bottomRight = cellAt(x + 1, y + 1);
+        bool west = bx > 0 && (blockEdges[b - 1] & edgeEast);
+        bool north = by > 0 && (blockEdges[b - blocksX] & edgeSouth);
+
+        next[topLeft] = west ? cellAt(x - 1, y) : bottomLeft;
+        next[topRight] = north ? cellAt(x + 1, y - 1) : topLeft;
+
+        if (blockEdges[b] & edgeEast) {
+            next[bottomRight] = cellAt(x + 2, y + 1);
+        }
+        else if (extraColumn && bx == blocksX - 1 && map.get(xEnd, y) != wall && map.get(xEnd, y + 1) != wall) {
+            // 多出的一列：右下 -> 右侧两格 -> 右上
+            next[bottomRight] = cellAt(xEnd, y + 1);
+            next[cellAt(xEnd, y + 1)] = cellAt(xEnd, y);
+            next[cellAt(xEnd, y)] = topRight;
+        }
+        else {
+            next[bottomRight] = topRight;
+        }
+
+        if (blockEdges[b] & edgeSouth) {
+            next[bottomLeft] = cellAt(x, y + 2);
+        }
+        else if (extraRow && by == blocksY - 1 && map.get(x, yEnd) != wall && map.get(x + 1, yEnd) != wall) {
+            // 多出的一行：左下 -> 下方两格 -> 右下
+            next[bottomLeft] = cellAt(x, yEnd);
+            next[cellAt(x, yEnd)] = cellAt(x + 1, yEnd);
+            next[cellAt(x + 1, yEnd)] = bottomRight;
+        }
+        else {
+            next[bottomLeft] = bottomRight;
+        }
+    }
+
+    // 沿环走一圈编号，序号取偶数，给角上的绕行格留出奇数序号
+    int start = cellAt(areaX + 2 * (root % blocksX), areaY + 2 * (root / blocksX));
+    int cell = start;
+    do {
+        order[cell] = 2 * cycleLength++;
+        cell = next[cell];
+    } while (cell != start && cycleLength < width * height);
+
+    // 两边都为奇数时角上的格子不在环上：把它当作 左侧格 -> 角 -> 上方格 的绕行（跳过最后一块的右下角），
+    // 序号夹在左侧格与右下角之间，食物落在角上时也能吃到
+    if (extraColumn && extraRow && map.get(xEnd, yEnd) != wall) {
+        int corner = cellAt(xEnd, yEnd);
+        int entry = cellAt(xEnd - 1, yEnd);
+        int lastBottomRight = cellAt(xEnd - 1, yEnd - 1);
+        if (order[lastBottomRight] >= 0 && next[lastBottomRight] == cellAt(xEnd, yEnd - 1)
+            && next[entry] == lastBottomRight) {
+            order[corner] = order[entry] + 1;
+            next[corner] = cellAt(xEnd, yEnd - 1);
+        }
+    }
+
+    buildTime.add(elapsedMs(begin, chrono::steady_clock::now()));
+}
+
+Direction HamiltonAI::decide(const Snake& self, const Snake* rival) {
+    (void)rival;
+    checkWalls();
+
+    const GameMap& map = sim.getMap();
+    auto head = self.getHeadPos();
+    auto tail = self.getBody().back();
+    int headCell = cellAt(head.first, head.second);
+    int tailCell = cellAt(tail.first, tail.second);
+    Direction back = oppositeDirection(self.getDirection());
+
+    // 蛇头或蛇尾不在环上（重生在环外的格子，或环刚重建），先走到任意可走的格子，优先环上的
+    if (cycleLength == 0 || order[headCell] < 0 || order[tailCell] < 0) {
+        Direction fallback = stop;
+        for (int d = up; d <= right_dir; ++d) {
+            int nx = head.first + dirX[d], ny = head.second + dirY[d];
+            if (d == back || !map.inBounds(nx, ny) || !passable(map, cellAt(nx, ny), tailCell)) {
+                continue;
+            }
+            if (order[cellAt(nx, ny)] >= 0) {
+                return static_cast<Direction>(d);
+            }
+            if (fallback == stop) {
+                fallback = static_cast<Direction>(d);
+            }
+        }
+        return fallback;
+    }
+
+    int n = 2 * cycleLength;
+    int tailOrder = order[tailCell];
+    int headRel = (order[headCell] - tailOrder + n) % n;
+
+    // 目标：沿环向前最近的食物
+    int target = -1, targetDist = n;
+    for (const Food& f : sim.getFoodManager().getFoodList()) {
+        int c = cellAt(f.x, f.y);
+        if (order[c] < 0) {
+            continue;
+        }
+        int d = (order[c] - order[headCell] + n) % n;
+        if (d > 0 && d < targetDist) {
+            target = c;
+            targetDist = d;
+        }
+    }
+
+    // 候选：沿环的序号大于蛇头（不绕过蛇尾）的相邻格都是安全的，环上的后继自然满足
+    // 蛇尾与蛇身倒数第二节之间被跳过的空格也可以走：这一步不吃东西，蛇尾随即前移，序号关系重新成立
+    auto rel = [&](int cell) {
+        return (order[cell] - tailOrder + n) % n;
+    };
+    const SnakeBody& body = self.getBody();
+    int afterTail = -1, afterTailRel = n;
+    if (body.size() > 1) {
+        auto p = body[body.size() - 2];
+        afterTail = cellAt(p.first, p.second);
+        afterTailRel = rel(afterTail);
+    }
+    // 地图上只剩最后一个食物且没有空格时，吃掉它地图就满了，对局随即结束，不必再考虑之后的路
+    bool lastFood = map.getFreeCount() == 0 && sim.getFoodManager().getFoodList().size() == 1;
+    int successor = next[headCell];
+    Direction best = stop;
+    int bestCell = -1, bestDist = n + 1;
+    bool targetBlocked = false;
+    // 所有候选都不安全时（如吃掉角上的食物后新食物恰好刷在出口）退而走任意可走的格子，总比撞墙好
+    Direction lastResort = stop;
+    for (int d = up; d <= right_dir; ++d) {
+        int nx = head.first + dirX[d], ny = head.second + dirY[d];
+        if (d == back || !map.inBounds(nx, ny)) {
+            continue;
+        }
+        int c = cellAt(nx, ny);
+        if (order[c] < 0 || !passable(map, c, tailCell)) {
+            continue;
+        }
+        if (lastFood && map.getCell(c) == food) {
+            return static_cast<Direction>(d);
+        }
+        if (lastResort == stop) {
+            lastResort = static_cast<Direction>(d);
+        }
+        if (c != tailCell && rel(c) <= headRel && !(map.getCell(c) == emptyInfo && rel(c) < afterTailRel)) {
+            targetBlocked = targetBlocked || c == target;
+            continue;
+        }
+        // 角上的绕行格跳过了一格，进去之后下一步只能走它的后继：后继必须是（这一步之后的）蛇尾、空格，或仍在前方的食物
+        int exit = next[c];
+        if ((order[exit] - order[c] + n) % n > 2 && exit != tailCell && !(c == tailCell && exit == afterTail)
+            && map.getCell(exit) != emptyInfo
+            && !(map.getCell(exit) == food && rel(exit) > rel(c))) {
+            targetBlocked = targetBlocked || c == target;
+            continue;
+        }
+        int dist = n;
+        if (c == target) {
+            dist = 0;
+        }
+        else if (target >= 0 && strictMoves == 0) {
+            dist = (order[target] - order[c] + n) % n;
+        }
+        else if (c == successor) {
+            // 没有目标或只沿环走的那一圈里走后继
+            dist = 1;
+        }
+        if (dist < bestDist || (dist == bestDist && c == successor)) {
+            best = static_cast<Direction>(d);
+            bestCell = c;
+            bestDist = dist;
+        }
+    }
+    if (strictMoves > 0) {
+        --strictMoves;
+    }
+    // 食物就在旁边却走不进去（奇数场地角上的绕行格附近），说明蛇身相对环的位置会一圈圈重复；
+    // 接下来一圈老老实实沿环走，把被捷径跳过的格子补上，错开蛇头与蛇尾的相位
+    if (targetBlocked) {
+        strictMoves = cycleLength;
+    }
+    if (best == stop) {
+        return lastResort;
+    }
+    if (bestCell != successor) {
+        ++shortcuts;
+    }
+    return best;
+}
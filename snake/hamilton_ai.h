@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ai_input.h"
+
+// 哈密顿环 AI：沿一条经过场地内每个格子的环移动，不会撞到自己，最终能铺满整张地图
+// 环的构造：把边框以内的场地按 2x2 分块，在不含墙的块上求生成树，绕生成树走一圈即得到环；
+// 场地宽或高为奇数时多出的一列/一行拼接到相邻块上；两者都为奇数时格子总数为奇数，不存在哈密顿环，
+// 角上的一格作为绕行处理
+// 捷径：设蛇尾在环上的序号为 0，蛇身各节沿环的序号从尾到头递增；
+// 只要新蛇头的序号仍大于旧蛇头、且不绕过蛇尾，这个性质就保持，因此可以直接跳到离食物更近的相邻格
+// 捷径会让蛇身绕出固定的一圈，旁边的食物总在蛇身后面吃不到时，沿环老老实实走一圈错开位置
+// 尸体变成的墙落在环上时重新构造环，其余时间每步只需 O(1) 加上遍历食物列表
+// 两边都为奇数的场地上，新食物连续刷在角上绕行格的出口时仍可能被困住，极少发生
+class HamiltonAI : public AIInput {
+private:
+    int width, height;
+    // 场地（边框以内）的左上角与尺寸，以及 2x2 块的行列数
+    int areaX, areaY, areaWidth, areaHeight;
+    int blocksX, blocksY;
+
+    // 每个格子在环上的后继与序号，不在环上的为 -1
+    // 序号是环上位置的两倍，角上的绕行格取两个相邻格之间的奇数序号
+    std::vector<int> next;
+    std::vector<int> order;
+    int cycleLength;
+
+    // 生成树：块是否可用、是否已加入树，以及向右/向下的树边
+    std::vector<uint8_t> blockFree;
+    std::vector<uint8_t> blockInTree;
+    std::vector<uint8_t> blockEdges;
+    std::vector<int> blockQueue;
+
+    // 已检查过的墙的数量，墙列表变长时只检查新增的墙
+    size_t wallsSeen;
+    bool built;
+    // 大于 0 时只沿环走、不走捷径的剩余步数
+    int strictMoves;
+
+    // 构造环的次数与耗时、走捷径的步数
+    TimingStat buildTime;
+    long long shortcuts;
+
+    int cellAt(int x, int y) const {
+        return y * width + x;
+    }
+
+    // 墙有变化（新的一局或尸体变墙落在环上）时重新构造环
+    void checkWalls();
+    // 按当前地图上的墙构造环，生成树从 startCell 所在的块开始
+    void rebuild(int startCell);
+
+public:
+    HamiltonAI(const Simulation& sim_, int player_, InputSource* others_ = nullptr);
+
+    // 环上的格子数
+    int getCycleLength() const {
+        return cycleLength;
+    }
+
+    // 格子沿环的后继，不在环上返回 -1
+    int getNext(int cell) const {
+        return next[cell];
+    }
+
+    const TimingStat& getBuildTime() const {
+        return buildTime;
+    }
+
+    long long getShortcuts() const {
+        return shortcuts;
+    }
+
+    void resetStats() override {
+        AIInput::resetStats();
+        buildTime.reset();
+        shortcuts = 0;
+    }
+
+protected:
+    Direction decide(const Snake& self, const Snake* rival) override;
+};
@@ -1,1514 +1,1268 @@
-#include <iostream>
-#include <vector>
-#include <deque>
-#include <string>
-#include <ctime>
-#include <conio.h> 
-#include <graphics.h> 
-#include <windows.h> 
-
-using namespace std;
-
-// --- ȫֳ ---
-
-
-const int windowWidth = 1440; // 󴰿ڿ
-const int windowHeight = 720; // 󴰿ڸ߶
-const int gridSize = 40;      // С
-const int mapWidth = (windowWidth - 240) / gridSize;
-const int mapHeight = (windowHeight) / gridSize; // ԤUI
-
-
-// --- öͶ ---
-enum Direction { stop = 0, up, down, left_dir, right_dir };
-enum GameState { menu = 0, singleMode, pairMode, viewRecords, gameOver };
-enum MapElement { emptyInfo = 0, food, snake1Body, snake2Body, wall };
-enum GameVersion { selecting = 0, beginner, advanced, expert };
-enum keyStatus { none = 0, p1, p2, func };
-
-
-// ͼ״̬Ϊȫֱ
-MapElement gameMap[mapWidth][mapHeight];
-
-// ʼͼ״̬
-void resetGameMap() {
-    for (int i = 0; i < mapWidth; ++i) {
-        for (int j = 0; j < mapHeight; ++j) {
-            gameMap[i][j] = emptyInfo;
-        }
-    }
-}
-
-// ȡλ
-pair<int, int> getRandomEmptyPosition() {
-    vector<pair<int, int>> emptyPositions;
-    for (int i = 0; i < mapWidth; ++i) {
-        for (int j = 0; j < mapHeight; ++j) {
-            if (gameMap[i][j] == emptyInfo) {
-                emptyPositions.push_back(make_pair(i, j));
-            }
-        }
-    }
-    if (emptyPositions.empty()) {
-        return make_pair(-1, -1); // ޿λ
-    }
-
-    int idx = rand() % emptyPositions.size();
-    return emptyPositions[idx];
-}
-
-// 봦 - ̺
-class inputHandler {
-private:
-    // Ƿ
-    bool leftButtonDown;
-    // ҪǷֹһ֡ڰ¶µĳЩûʶ
-    deque<pair<int, keyStatus>> keyBuffer;
-
-public:
-    inputHandler() : leftButtonDown(false) {
-    }
-
-    // ״̬
-    void updateMouse() {
-        // ǷϢ
-        if (MouseHit()) {
-            MOUSEMSG msg = GetMouseMsg();
-            if (msg.uMsg == WM_LBUTTONDOWN) {
-                leftButtonDown = true;
-            }
-            else {
-                leftButtonDown = false;
-            }
-        }
-        else {
-            leftButtonDown = false;
-        }
-    }
-
-    // Ƿ
-    bool isLeftButtonDown() const {
-        return leftButtonDown;
-    }
-
-    // ȡʵʱλ
-    pair<int, int> getMousePos() const {
-        POINT pt;
-        GetCursorPos(&pt);
-        // ĻתΪ
-        ScreenToClient(GetHWnd(), &pt);
-        return make_pair(pt.x, pt.y);
-    }
-
-    // Ƿͣھڣͣڰťϵļ
-    bool isMouseHoveringInRect(int x1, int y1, int x2, int y2) const {
-        auto pos = getMousePos();
-        return (pos.first >= x1 && pos.first <= x2 && pos.second >= y1 && pos.second <= y2);
-    }
-
-    void clearKeyBuffer() {
-        keyBuffer.clear();
-    }
-
-    // ϵͳȡпð׷ӵβ
-    void fetchNewKeys() {
-        while (_kbhit()) {
-            int key = _getch();
-            switch (key) {
-            case 'q': case 'Q':case 'p': case 'P':case 27: case 'r':case 'R':
-                // ֱӼ뻺
-                keyBuffer.push_back(make_pair(key, func));
-                continue;
-            }
-
-            switch (key) {
-            case 'W': case 'w':case 'A': case 'a':case 'S': case 's':case 'D': case 'd':
-                // ֱӼ뻺
-                keyBuffer.push_back(make_pair(key, p1));
-                continue;
-            }
-
-            if (key == 0xE0) {
-                // չٶһ
-                if (_kbhit()) {
-                    int ext = _getch();
-                    switch (ext) {
-                    case 72: key = VK_UP; break;
-                    case 80: key = VK_DOWN; break;
-                    case 75: key = VK_LEFT; break;
-                    case 77: key = VK_RIGHT; break;
-                    default: key = 0; // δ֪չ
-                    }
-                }
-                else {
-                    key = 0; // չ
-                }
-            }
-            else {
-                key = 0; // չ
-            }
-            // ʱһΪp2ļ
-            if (key != 0) {
-                keyBuffer.push_back(make_pair(key, p2));
-            }
-        }
-    }
-
-    // ȡһָ͵İ
-    pair<int, keyStatus> getKey(keyStatus keyType) {
-        // Ȼȡ°
-        fetchNewKeys();
-
-        for (size_t i = 0; i < keyBuffer.size(); ++i) {
-            if (keyBuffer[i].second == keyType) {
-                auto key = keyBuffer[i];
-                // ֻƳü
-                keyBuffer.erase(keyBuffer.begin() + i);
-                return key;
-            }
-        }
-        return make_pair(-1, none); // δҵ
-    }
-};
-
-//
-class Snake {
-private:
-    // ʹ˫˶зͷβ
-    deque<pair<int, int>> body;
-    // ̰ߵƶ
-    Direction dir;
-    // ߵɫ
-    int color;
-    // 1 or 2
-    int playerId;
-    // ߵֵ
-    int life;
-    //ǷԵʳ
-    bool isEat;
-    // ͷͼ
-    IMAGE imgHead;
-
-    // ص
-    // ʹ֡ƶٶȣӶ˫ģʽʵһֻ߼ٶһֻ
-    // ļͨıƶ֡ʵֵ
-
-    // Ƿڼ״̬
-    bool isSpeedUp;
-    // ٳʱ䣨֡Ϊλ
-    int speedUpDuration;
-    // Ǽٿʼʱ䣨֡Ϊλ
-    int markTime;
-    // ÿ֡ݼ0ƶ
-    int moveCounter;
-    // ÿ֡ƶһ
-    int moveInterval;
-
-public:
-    Snake(int playerID)
-        : playerId(playerID), life(1), isEat(false), dir(stop),
-        speedUpDuration(10), markTime(-100), isSpeedUp(false), moveCounter(0), moveInterval(9) {
-        // ڹ캯мͷͼöӦɫ
-        if (playerId == 1) {
-            if (loadimage(&imgHead, _T("pictures/snake_head1.png"))) {
-                cerr << "Failed to load snake_head1.png" << endl;
-            }
-            color = RED;
-        }
-        else {
-            if (loadimage(&imgHead, _T("pictures/snake_head2.png"))) {
-                cerr << "Failed to load snake_head2.png" << endl;
-            }
-            color = BLUE;
-        }
-    }
-
-    // ͷλ
-    pair<int, int> findNewHead() {
-        if (body.empty() || life <= 0) {
-            // Чλ
-            return make_pair(-1, -1);
-        }
-        else {
-            auto head = body.front();
-            int newX = head.first;
-            int newY = head.second;
-
-            switch (dir) {
-            case up:    newY--; break;
-            case down:  newY++; break;
-            case left_dir:  newX--; break;
-            case right_dir: newX++; break;
-            case stop: break;
-            }
-
-            return make_pair(newX, newY);
-        }
-    }
-
-    // ƶ
-    void move() {
-        if (life <= 0 || body.empty()) {
-            return;
-        }
-
-        pair<int, int> newHead = findNewHead();
-
-        // ͷ
-        body.push_front(newHead);
-
-        // ûгԵʳƳβ
-        if (gameMap[newHead.first][newHead.second] != food) {
-            isEat = false;
-            auto tail = body.back();
-            gameMap[tail.first][tail.second] = emptyInfo;
-            body.pop_back();
-        }
-        else {
-            isEat = true;
-        }
-
-        gameMap[newHead.first][newHead.second] = (playerId == 1) ? snake1Body : snake2Body;
-    }
-
-    // ıߵƶ
-    void changeDirection(pair<int, keyStatus> key) {
-        // 򲻸ı䷽
-        if (life <= 0 || body.empty()) return;
-
-        // 1ʹWASD
-        if (playerId == 1 && key.second == p1) {
-            switch (key.first) {
-            case 'W': case 'w': if (dir != down) dir = up; break;
-            case 'S': case 's': if (dir != up) dir = down; break;
-            case 'A': case 'a': if (dir != right_dir) dir = left_dir; break;
-            case 'D': case 'd': if (dir != left_dir) dir = right_dir; break;
-            }
-        }
-        // 2ʹüͷ
-        else if (playerId == 2 && key.second == p2) {
-            switch (key.first) {
-            case VK_UP:    if (dir != down) dir = up; break;
-            case VK_DOWN:  if (dir != up) dir = down; break;
-            case VK_LEFT:  if (dir != right_dir) dir = left_dir; break;
-            case VK_RIGHT: if (dir != left_dir) dir = right_dir; break;
-            }
-        }
-    }
-
-    // ǷΪβλ,ҪnewHeadΪǰβλõ
-    bool isTail(pair<int, int> pos) {
-        auto tail = body.back();
-        return tail.first == pos.first && tail.second == pos.second;
-    }
-
-    // ײ
-    bool checkCollision(pair<int, int> pos) {
-        if (pos.first < 0 || pos.first >= mapWidth || pos.second < 0 || pos.second >= mapHeight
-            || (gameMap[pos.first][pos.second] == snake1Body && !isTail(pos))
-            || (gameMap[pos.first][pos.second] == snake2Body && !isTail(pos))
-            || (gameMap[pos.first][pos.second] == wall)) {
-            return true;
-        }
-        return false;
-    }
-
-    // 
-    void draw() {
-        // 򲻻
-        if (life <= 0 || body.empty()) return;
-        // 
-        for (size_t i = 1; i < body.size(); ++i) {
-            auto pos = body[i];
-            setfillcolor(color);
-            solidrectangle(pos.first * gridSize, pos.second * gridSize, (pos.first + 1) * gridSize, (pos.second + 1) * gridSize);
-        }
-
-        // ͷ
-        if (!body.empty()) {
-            auto headPos = body.front();
-            putimage(headPos.first * gridSize, headPos.second * gridSize, &imgHead);
-        }
-    }
-
-    // ߵλú״̬ûдʼһ
-    bool reset(int life_, Direction newDir = static_cast<Direction>(rand() % 4 + 1)) {
-        body.clear();
-        if (life_ < 0) {
-            return true;
-        }
-        if (life_ == 0) {
-            life = 0;
-            return true;
-        }
-        auto newPos = getRandomEmptyPosition();
-
-        // ޷ãͼ
-        if (newPos.first == -1) {
-            return false;
-        }
-        else {
-            body.push_back(newPos);
-            gameMap[newPos.first][newPos.second] = (playerId == 1) ? snake1Body : snake2Body;
-            dir = newDir;
-            isEat = false;
-            life = life_;
-            moveCounter = 0;
-            isSpeedUp = false;
-            markTime = -100;
-            return true;
-        }
-    }
-
-    // ȡǷԵʳ״̬
-    bool isEatState() {
-        return isEat;
-    }
-
-    // óԵʳ״̬
-    void resetEat() {
-        isEat = false;
-    }
-
-    // ȡλ
-    const deque<pair<int, int>>& getBody() const {
-        return body;
-    }
-
-    // ȡͷλ
-    pair<int, int> getHeadPos() const {
-        if (body.empty()) {
-            return make_pair(-2, -2); // Чλ
-        }
-        else {
-            return body.front();
-        }
-    }
-
-    // ȡߵֵ
-    int getLife() const {
-        return life;
-    }
-
-
-    // ȡǷ״̬
-    bool getIsSpeedUp() const {
-        return isSpeedUp;
-    }
-
-    // ÿ֡ã¼״̬
-    void updateSpeedState(int gameTime) {
-        isSpeedUp = (gameTime < markTime + speedUpDuration);
-
-        moveInterval = isSpeedUp ? 5 : 9;
-    }
-
-    // ü״̬
-    void setSpeedUp(int gameTime) {
-        isSpeedUp = true;
-        markTime = gameTime;
-    }
-
-    // ÿ֡ãǷƶ
-    bool shouldMoveThisFrame() {
-        // ˾Ͳƶ
-        if (life <= 0 || body.empty()) return false;
-        moveCounter++;
-        if (moveCounter >= moveInterval) {
-            moveCounter = 0;
-            return true;
-        }
-        return false;
-    }
-};
-
-// ʳṹ
-struct Food {
-    int x, y;
-    int ID;
-    int foodScore;
-    Food(int x_, int y_, int ID_) : x(x_), y(y_), ID(ID_) {
-        // IDʳ
-        foodScore = ID + 1;
-    }
-};
-
-// ʳ
-class FoodManager {
-private:
-    vector<Food> foodList;
-    vector<IMAGE*> imgFood;
-public:
-    FoodManager() {
-        // ʼʳб
-        foodList.clear();
-
-        // ʳͼƬ
-        IMAGE* food1 = new IMAGE, * food2 = new IMAGE, * food3 = new IMAGE, * food4 = new IMAGE, * food5 = new IMAGE;
-        loadimage(food1, _T("pictures/food1.png"));
-        loadimage(food2, _T("pictures/food2.png"));
-        loadimage(food3, _T("pictures/food3.png"));
-        loadimage(food4, _T("pictures/food4.png"));
-        loadimage(food5, _T("pictures/food5.png"));
-        imgFood.push_back(food1);
-        imgFood.push_back(food2);
-        imgFood.push_back(food3);
-        imgFood.push_back(food4);
-        imgFood.push_back(food5);
-    }
-
-    // ͷŶ̬ڴ
-    ~FoodManager() {
-        for (auto img : imgFood) {
-            delete img;
-        }
-    }
-
-    // ʳб
-    void reset() {
-        foodList.clear();
-    }
-
-    // 1~5ʳǷɳɹ
-    // boolֵҪڼͼǷҲģʽǷ
-    bool generateFood() {
-        int i = rand() % 5 + 1;
-        for (int j = 0; j < i; ++j) {
-            auto pos = getRandomEmptyPosition();
-            if (pos.first != -1) {
-                foodList.push_back(Food(pos.first, pos.second, rand() % 5));
-                gameMap[pos.first][pos.second] = food;
-            }
-            else {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    // ߵʬΪʳ
-    void addFood(const deque<pair<int, int>>& body) {
-        for (const auto& pos : body) {
-            foodList.push_back(Food(pos.first, pos.second, (rand() % 5)));
-            gameMap[pos.first][pos.second] = food;
-        }
-    }
-
-    // ʳ
-    void draw() {
-        for (const auto& f : foodList) {
-            if (f.ID >= 0 && f.ID < (int)imgFood.size()
-                && imgFood[f.ID] != nullptr && imgFood[f.ID]->getwidth() > 0) {
-                putimage(f.x * gridSize, f.y * gridSize, imgFood[f.ID]);
-            }
-            else {
-                // fallbackɫԲ
-                setfillcolor(GREEN);
-                solidcircle(f.x * gridSize + gridSize / 2,
-                    f.y * gridSize + gridSize / 2,
-                    gridSize / 2);
-            }
-        }
-    }
-
-    // Ƴָλõʳ
-    void removeFood(pair<int, int> pos) {
-        foodList.erase(
-            remove_if(foodList.begin(), foodList.end(),
-                [pos](const Food& f) {
-                    return f.x == pos.first && f.y == pos.second;
-                }),
-            foodList.end());
-    }
-
-    // ʳбǷΪ
-    bool foodEmpty() {
-        return foodList.empty();
-    }
-
-    // ȡָλʳķ
-    int getScore(pair<int, int> pos) {
-        for (const auto& f : foodList) {
-            if (f.x == pos.first && f.y == pos.second) {
-                return f.foodScore;
-            }
-        }
-        return 0;
-    }
-};
-
-// ǽ
-class WallManager {
-private:
-    vector<pair<int, int>> wallList;
-
-public:
-    WallManager() {
-        reset();
-    }
-
-    // ǽλ
-    void reset() {
-        wallList.clear();
-        for (int i = 0; i < mapWidth; ++i) {
-            wallList.push_back(make_pair(i, 0));
-            wallList.push_back(make_pair(i, mapHeight - 1));
-            gameMap[i][0] = wall;
-            gameMap[i][mapHeight - 1] = wall;
-        }
-        for (int j = 0; j < mapHeight; ++j) {
-            wallList.push_back(make_pair(0, j));
-            wallList.push_back(make_pair(mapWidth - 1, j));
-            gameMap[0][j] = wall;
-            gameMap[mapWidth - 1][j] = wall;
-        }
-    }
-
-    // ǽ
-    void addWall(const deque<pair<int, int>>& body) {
-        for (const auto& pos : body) {
-            wallList.push_back(pos);
-            gameMap[pos.first][pos.second] = wall;
-        }
-    }
-
-    // ǽ
-    void drawWalls() {
-        for (const auto& wall : wallList) {
-            int x = wall.first;
-            int y = wall.second;
-            setfillcolor(BLACK);
-            solidrectangle(x * gridSize, y * gridSize, (x + 1) * gridSize, (y + 1) * gridSize);
-        }
-    }
-};
-
-// ¼Ϣṹ
-struct info {
-    int timeTaken;
-    int score1, score2;
-
-    // ͬʱڵ˺˫ģʽĹ캯
-    info(int timeTaken_ = 0, int score_1 = 0, int score2_ = -1) : score1(score_1), score2(score2_), timeTaken(timeTaken_) {
-    }
-};
-
-// ¼
-class RecordManager {
-private:
-    info singleBestScore[3];
-    info pairBestScore[3];
-public:
-    // 캯ʼ¼
-    RecordManager() {
-        for (int i = 0; i < 3; ++i) {
-            singleBestScore[i] = info(0, 0);
-            pairBestScore[i] = info(0, 0, 0);
-        }
-    }
-
-    // µģʽ¼
-    void updateSingleInfo(int mode, info newInfo) {
-        if (newInfo.score1 > singleBestScore[mode].score1) {
-            singleBestScore[mode] = newInfo;
-        }
-    }
-
-    // ˫ģʽ¼
-    void updatePairInfo(int mode, info newInfo) {
-        int totalScore = newInfo.score1 + newInfo.score2;
-        int bestTotalScore = pairBestScore[mode].score1 + pairBestScore[mode].score2;
-        if (totalScore > bestTotalScore) {
-            pairBestScore[mode] = newInfo;
-        }
-    }
-
-    // ȡģʽ¼
-    info getSingleBestInfo(int mode) {
-        return singleBestScore[mode];
-    }
-
-    // ȡ˫ģʽ¼
-    info getPairBestInfo(int mode) {
-        return pairBestScore[mode];
-    }
-};
-
-// Ϸ߼
-class Game {
-private:
-    // ͼĸԪ
-    Snake snake1, snake2;
-    FoodManager foodManager;
-    WallManager wallManager;
-
-    // Ϸʱ
-    int gameTime;
-    clock_t startTime;
-
-    // Ϸ״̬
-    pair<GameState, GameVersion> lastState, state;
-
-    // 봦
-    inputHandler inputHandler;
-
-    // Ϸʷ¼
-    int score1, score2;
-    int winner;
-    RecordManager recordManager;
-
-    // ͼƬ
-    vector<IMAGE*> imgBackgrounds;
-
-public:
-    // 캯
-    Game() : score1(0), score2(0), gameTime(0), startTime(0),
-        snake1(1), snake2(2), winner(0) {
-        state = lastState = make_pair(menu, selecting);
-        resetGameMap();
-        IMAGE* menuBg = new IMAGE;
-        IMAGE* menuBg1 = new IMAGE; IMAGE* menuBg2 = new IMAGE; IMAGE* menuBg3 = new IMAGE; IMAGE* menuBg4 = new IMAGE;
-
-        IMAGE* selectBg1 = new IMAGE; IMAGE* selectBg2 = new IMAGE; IMAGE* selectBg3 = new IMAGE; IMAGE* selectBg4 = new IMAGE;
-
-        loadimage(menuBg, _T("pictures/menuBg.png"));
-        loadimage(menuBg1, _T("pictures/menuBg1.png"));
-        loadimage(menuBg2, _T("pictures/menuBg2.png"));
-        loadimage(menuBg3, _T("pictures/menuBg3.png"));
-        loadimage(menuBg4, _T("pictures/menuBg4.png"));
-        loadimage(selectBg1, _T("pictures/selectBg1.png"));
-        loadimage(selectBg2, _T("pictures/selectBg2.png"));
-        loadimage(selectBg3, _T("pictures/selectBg3.png"));
-        loadimage(selectBg4, _T("pictures/selectBg4.png"));
-        imgBackgrounds.push_back(menuBg);
-        imgBackgrounds.push_back(menuBg1);
-        imgBackgrounds.push_back(menuBg2);
-        imgBackgrounds.push_back(menuBg3);
-        imgBackgrounds.push_back(menuBg4);
-        imgBackgrounds.push_back(selectBg1);
-        imgBackgrounds.push_back(selectBg2);
-        imgBackgrounds.push_back(selectBg3);
-        imgBackgrounds.push_back(selectBg4);
-    }
-
-    // Ϸѭ
-    void run() {
-        while (true) {
-            inputHandler.clearKeyBuffer();
-            switch (state.first) {
-            case menu:
-                handleMenu();
-                break;
-            case viewRecords:
-                handleViewRecords();
-                break;
-            case singleMode:
-            case pairMode:
-                if (state.second == selecting) {
-                    handleSelectVersion();
-                }
-                else {
-                    init();
-                    while ((state.first == singleMode || state.first == pairMode)
-                        && state.second != selecting) {
-                        update();
-                        render();
-                        Sleep(10);
-                    }
-                }
-                break;
-
-            case gameOver:
-                handleGameOver();
-                break;
-            default:
-                exit(1);
-            }
-        }
-    }
-
-    // ˵
-    void handleMenu() {
-        // ťߴλ
-        const int btnW = 400;
-        const int btnH = 100;
-        const int centerX = windowWidth * 3 / 4;
-        const int startY = 200;
-
-        while (state.first == menu) {
-            inputHandler.clearKeyBuffer();
-            inputHandler.updateMouse();
-            BeginBatchDraw();
-            cleardevice();
-
-            putimage(0, 0, imgBackgrounds[0]);
-
-            // ⣨Ҳı
-            settextstyle(48, 0, _T("SimHei"));
-            settextcolor(RED);
-            outtextxy(centerX - 200, 80, _T("ӭ̰ҫ"));
-
-            const TCHAR* labels[] = {
-                _T("Ҷ飡"),
-                _T("ħ & "),
-                _T("ʷθ"),
-                _T("߳")
-            };
-
-            int y = startY;
-            for (int i = 0; i < 4; ++i) {
-                int x = centerX - btnW / 2;
-                COLORREF textCol = BLACK;
-
-                // ͣ
-                if (inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
-                    textCol = RED;    // ͣɫ
-                    clearrectangle(0, 0, 720, 720);
-                    putimage(0, 0, imgBackgrounds[1 + i % 4]); // 
-                }
-
-                drawTextWithBackground(labels[i], x, y, btnW, btnH, textCol);
-
-                // ⣨þ
-                if (inputHandler.isLeftButtonDown() &&
-                    inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
-                    if (i == 0) {
-                        state = make_pair(singleMode, selecting);
-                    }
-                    else if (i == 1) {
-                        state = make_pair(pairMode, selecting);
-                    }
-                    else if (i == 2) {
-                        state = make_pair(viewRecords, selecting);
-                    }
-                    else if (i == 3) {
-                        exit(0);
-                    }
-                }
-
-                y += 120;
-            }
-
-            EndBatchDraw();
-            Sleep(10);
-        }
-    }
-
-    // 汾ѡ
-    void handleSelectVersion() {
-        // ťߴλ
-        const int btnW = 400;
-        const int btnH = 100;
-        const int centerX = windowWidth * 3 / 4;
-        const int startY = 200;
-
-        while (state.second == selecting && (state.first == singleMode || state.first == pairMode)) {
-            inputHandler.clearKeyBuffer();
-            inputHandler.updateMouse();
-            BeginBatchDraw();
-
-            cleardevice();
-
-            if (state.first == singleMode) {
-                putimage(0, 0, imgBackgrounds[1]);
-            }
-            else {
-                putimage(0, 0, imgBackgrounds[2]);
-            }
-
-            // 
-            settextstyle(48, 0, _T("SimHei"));
-            settextcolor(RED);
-            outtextxy(centerX - 200, 80, _T("ѡĶԾѶ"));
-
-            const TCHAR* labels[] = {
-                _T("սʿ(Ű)"),
-                _T("(װ)"),
-                _T("̹(߼)"),
-                _T("")
-            };
-
-            int y = startY;
-            for (int i = 0; i < 4; ++i) {
-                int x = centerX - btnW / 2;
-                COLORREF textCol = BLACK;
-
-                // ͣ
-                if (inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
-                    textCol = RED;    // ͣɫ
-                    if (i != 3) {
-                        clearrectangle(0, 0, 720, 720);
-                        putimage(0, 0, imgBackgrounds[5 + i]); // 
-                    }
-                }
-
-                drawTextWithBackground(labels[i], x, y, btnW, btnH, textCol);
-
-                // ⣨þ
-                if (inputHandler.isLeftButtonDown() &&
-                    inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
-                    if (i == 0) { state.second = beginner; }
-                    else if (i == 1) { state.second = advanced; }
-                    else if (i == 2) { state.second = expert; }
-                    else if (i == 3) {
-                        state = make_pair(menu, selecting);
-                        return;
-                    }
-                }
-
-                y += 120; // 
-            }
-
-            // ˳
-            auto key = inputHandler.getKey(func);
-            if (key.first == 'q' || key.first == 'Q' || key.first == 27) {
-                state = make_pair(menu, selecting);
-            }
-
-            EndBatchDraw();
-            Sleep(10);
-        }
-    }
-
-    // 鿴¼
-    void handleViewRecords() {
-        // ťߴλ
-        const int btnW = 600;
-        const int btnH = 100;
-        const int spacingY = 80;
-        const int startX = windowWidth / 2 - btnW / 2;
-        const int startY = 100;
-
-        while (state.first == viewRecords) {
-            inputHandler.clearKeyBuffer();
-            inputHandler.updateMouse();
-            BeginBatchDraw();
-
-            //  + Ʊ
-            cleardevice();
-
-            // 
-            settextstyle(50, 0, _T("SimHei"));
-            settextcolor(RED);
-            outtextxy(startX + 150, 30, _T("ʷθ"));
-
-            // 汾ƣģ
-            const TCHAR* versionNames[2][3] = {
-                {_T("Ҷ顤սʿ(Ű)"), _T("Ҷ顤(װ)"), _T("Ҷ顤̹(߼)")},
-                {_T(" & ħ衤սʿ(Ű)"), _T(" & ħ衤(װ)"), _T(" & ħ衤̹(߼)")}
-            };
-
-            for (int i = 0; i < 3; ++i) {
-                // ˼¼
-                info singleInfo = recordManager.getSingleBestInfo(i);
-                TCHAR singleRecordText[256];
-                _stprintf_s(singleRecordText, 256, _T("%s\n߷: %d \nʱ: %d "),
-                    versionNames[0][i], singleInfo.score1, singleInfo.timeTaken);
-                drawTextWithBackground(singleRecordText, startX - 400, startY + i * 2 * spacingY, btnW, btnH);
-
-                // ˫˼¼
-                info pairInfo = recordManager.getPairBestInfo(i);
-                TCHAR pairRecordText[256];
-                _stprintf_s(pairRecordText, 256, _T("%s\n߷: %d \nʱ: %d "),
-                    versionNames[1][i], pairInfo.score1 + pairInfo.score2, pairInfo.timeTaken);
-                drawTextWithBackground(pairRecordText, startX + 400, startY + i * 2 * spacingY, btnW, btnH);
-            }
-
-            int returnBtnX = startX;
-            int returnBtnY = startY + 6 * spacingY;
-            drawTextWithBackground(_T(" "), returnBtnX, returnBtnY, btnW, btnH, BLACK, WHITE, RED, 3, 15);
-
-            if (inputHandler.isMouseHoveringInRect(returnBtnX, returnBtnY, returnBtnX + btnW, returnBtnY + btnH)) {
-                drawTextWithBackground(_T(" "), returnBtnX, returnBtnY, btnW, btnH, RED, WHITE, RED, 3, 15);
-            }
-
-            EndBatchDraw();
-
-            // 
-            if (inputHandler.isLeftButtonDown()) {
-                // ⷵذť
-                if (inputHandler.isMouseHoveringInRect(returnBtnX, returnBtnY, returnBtnX + btnW, returnBtnY + btnH)) {
-                    state = make_pair(menu, selecting);
-                }
-            }
-            auto key = inputHandler.getKey(func);
-            if (key.first == 'q' || key.first == 'Q' || key.first == 27) {
-                state = make_pair(menu, selecting);
-            }
-            Sleep(10);
-        }
-    }
-
-    // ͣ
-    void handlePause() {
-        // ťߴλ
-        const int btnW = 400;
-        const int btnH = 200;
-        const int spacingY = 150;
-        const int startX = windowWidth / 2 - btnW / 2;
-        const int startY = 400;
-
-        bool isPaused = true;
-
-        while (isPaused) {
-            inputHandler.clearKeyBuffer();
-            inputHandler.updateMouse();
-            BeginBatchDraw();
-
-            // 
-            cleardevice();
-
-            // 
-            settextstyle(50, 0, _T("SimHei"));
-            drawTextWithBackground(_T(" P ص\n Q OUT"), startX - 200, startY - 250, btnW + 400, btnH - 50, RED, WHITE, BLUE, 3, 20);
-            drawTextWithBackground(_T("ص"), startX - 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
-            drawTextWithBackground(_T("OUT"), startX + 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
-
-            if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
-                drawTextWithBackground(_T("ص"), startX - 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
-            }
-            else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
-                drawTextWithBackground(_T("OUT"), startX + 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
-            }
-
-            EndBatchDraw();
-
-            // 
-            if (inputHandler.isLeftButtonDown()) {
-                // ⷵذť
-                if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
-                    state = lastState;
-                    return;
-                }
-                else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
-                    state.first = gameOver;
-                    return;
-                }
-            }
-
-            // ̼
-            auto pauseKey = inputHandler.getKey(func);
-            if (pauseKey.first == 'p' || pauseKey.first == 'P') {
-                inputHandler.clearKeyBuffer();
-                isPaused = false;
-                return;
-            }
-            else if (pauseKey.first == 'q' || pauseKey.first == 'Q' || pauseKey.first == 27) { // ͣʱҲ Q
-                inputHandler.clearKeyBuffer();
-                state.first = gameOver;
-                return;
-            }
-            Sleep(10);
-        }
-    }
-
-    // Ϸ
-    void handleGameOver() {
-        // ȸʷ¼
-        if (lastState.first == singleMode) {
-            recordManager.updateSingleInfo(lastState.second - beginner, info(gameTime, score1));
-        }
-        else if (lastState.first == pairMode) {
-            recordManager.updatePairInfo(lastState.second - beginner, info(gameTime, score1, score2));
-        }
-
-        // ťߴλ
-        const int btnW = 400;
-        const int btnH = 200;
-        const int spacingY = 150;
-        const int startX = windowWidth / 2 - btnW / 2;
-        const int startY = 400;
-
-        while (state.first == gameOver) {
-            inputHandler.clearKeyBuffer();
-            inputHandler.updateMouse();
-            BeginBatchDraw();
-
-            // 
-            cleardevice();
-
-            // 
-            settextstyle(50, 0, _T("SimHei"));
-
-            TCHAR gameOverText[256];
-            if (lastState.first == singleMode) {
-                _stprintf_s(gameOverText, 256, _T("Ҷ飡\n: %d kg\nʱ: %d "),
-                    score1, gameTime);
-            }
-            else if (lastState.first == pairMode) {
-                _stprintf_s(gameOverText, 256,
-                    _T("ħ & \nħ: %d kg\n: %d kg\n: %d kg\nʱ: %d "),
-                    score1, score2, score1 + score2, gameTime);
-
-            }
-            drawTextWithBackground(gameOverText, startX - 200, startY - 250, btnW + 400, btnH, RED, WHITE, BLUE, 3, 20);
-            drawTextWithBackground(_T("һ"), startX - 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
-            drawTextWithBackground(_T("OUT"), startX + 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
-
-            if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
-                drawTextWithBackground(_T("һ"), startX - 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
-            }
-            else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
-                drawTextWithBackground(_T("OUT"), startX + 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
-            }
-
-            EndBatchDraw();
-
-            // 
-            if (inputHandler.isLeftButtonDown()) {
-                // ⷵذť
-                if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
-                    state = make_pair(lastState.first, lastState.second);
-                    init();
-                    return;
-                }
-                else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
-                    state = make_pair(lastState.first, selecting);
-                    return;
-                }
-            }
-
-            // ̼
-            auto pauseKey = inputHandler.getKey(func);
-            if (pauseKey.first == 'r' || pauseKey.first == 'R') {
-                inputHandler.clearKeyBuffer();
-                state = make_pair(lastState.first, lastState.second);
-                return;
-            }
-            else if (pauseKey.first == 'q' || pauseKey.first == 'Q' || pauseKey.first == 27) { // ͣʱҲ Q
-                inputHandler.clearKeyBuffer();
-                state = make_pair(lastState.first, selecting);
-                return;
-            }
-            Sleep(10);
-        }
-    }
-
-    // Ϸʼ
-    void init() {
-        score1 = score2 = 0;
-        gameTime = 0;
-        startTime = clock();
-
-        resetGameMap();
-
-        wallManager.reset();
-
-        // ŰΪ1
-        if (state.second == beginner) {
-            snake1.reset(1, stop);
-            if (state.first == pairMode) {
-                snake2.reset(1, stop);
-            }
-        }
-        // װֱʣռ䲻
-        else if (state.second == advanced) {
-            // ֵ϶ᳬͼܸ
-            snake1.reset(mapHeight * mapWidth, stop);
-            if (state.first == pairMode) {
-                snake2.reset(mapHeight * mapWidth, stop);
-            }
-        }
-        // ߼5
-        else if (state.second == expert) {
-            snake1.reset(5, stop);
-            if (state.first == pairMode) {
-                snake2.reset(5, stop);
-            }
-        }
-
-        foodManager.reset();
-        foodManager.generateFood();
-
-        inputHandler.clearKeyBuffer();
-    }
-
-    // 
-    void handleKey(bool move1, bool move2) {
-        pair<int, keyStatus> key = inputHandler.getKey(func);
-        lastState = state;
-        if (key.first == 'p' || key.first == 'P') {
-            inputHandler.clearKeyBuffer();
-            handlePause();
-            return;
-        }
-        else if (key.first == 27 || key.first == 'q' || key.first == 'Q') {
-            inputHandler.clearKeyBuffer();
-            state.first = gameOver;
-            return;
-        }
-
-        // ֻƶʱ߲Ŵ
-        if (move1) {
-            pair<int, keyStatus> key1 = inputHandler.getKey(p1);
-            snake1.changeDirection(key1);
-        }
-
-        if (move2 && state.first == pairMode) {
-            pair<int, keyStatus> key2 = inputHandler.getKey(p2);
-            snake2.changeDirection(key2);
-        }
-    }
-
-    // Ϸº
-    void update() {
-        // ϷѽҴͣ״ֱ̬ӷ
-        if (state.first == gameOver) {
-            return;
-        }
-
-        bool ended = false;
-        // Ϸʱ
-        gameTime = (clock() - startTime) / CLOCKS_PER_SEC;
-
-        snake1.updateSpeedState(gameTime);
-        if (state.first == pairMode) {
-            snake2.updateSpeedState(gameTime);
-        }
-
-        // Ƿƶ
-        bool move1 = snake1.shouldMoveThisFrame();
-        bool move2 = (state.first == pairMode) ? snake2.shouldMoveThisFrame() : false;
-
-        // Ƿ־
-        bool die1 = false;
-        bool die2 = false;
-
-        // 
-        handleKey(move1, move2);
-
-        auto newhead1 = snake1.findNewHead();
-        auto newhead2 = (state.first == pairMode) ? snake2.findNewHead() : make_pair(-1, -1);
-
-
-        //ͷײ
-        if (move1 || move2) {
-            if (state.first == pairMode && (newhead1 == newhead2 || newhead1 == snake2.getHeadPos()
-                || newhead2 == snake1.getHeadPos())) {
-                // ͷһ֡ͬһλãʱӦûҪƶһԸʳ״̬
-                if (newhead1 == newhead2 && newhead1 != snake1.getHeadPos() && newhead2 != snake2.getHeadPos()) {
-                    snake1.move();
-                    snake2.move();
-                }
-                if (state.second == beginner || state.second == expert) {
-                    // Ϊʳ
-                    foodManager.addFood(snake1.getBody());
-                    foodManager.addFood(snake2.getBody());
-                }
-
-                if (state.second == advanced) {
-                    // ߱Ϊǽ
-                    wallManager.addWall(snake1.getBody());
-                    wallManager.addWall(snake2.getBody());
-                }
-
-                if (!snake1.reset(snake1.getLife() - 1) || !snake2.reset(snake2.getLife() - 1) || !foodManager.generateFood()) {
-                    ended = true;
-                }
-            }
-            // ͨײ
-            else {
-                // 1ײ
-                if (move1) {
-                    if (snake1.checkCollision(newhead1)) {
-                        if (state.second == advanced) {
-                            wallManager.addWall(snake1.getBody());
-                        }
-                        else {
-                            foodManager.addFood(snake1.getBody());
-                        }
-
-                        if (!snake1.reset(snake1.getLife() - 1) || !foodManager.generateFood()) {
-                            ended = true;
-                        }
-                    }
-                    else {
-                        snake1.move();
-                    }
-                }
-
-                // 2ײ
-                if (state.first == pairMode) {
-                    if (move2) {
-                        if (snake2.checkCollision(newhead2)) {
-                            if (state.second == advanced) {
-                                wallManager.addWall(snake2.getBody());
-                            }
-                            else {
-                                foodManager.addFood(snake2.getBody());
-                            }
-
-                            if (!snake2.reset(snake2.getLife() - 1) || !foodManager.generateFood()) {
-                                ended = true;
-                            }
-                        }
-                        else {
-                            snake2.move();
-                        }
-                    }
-                }
-
-            }
-        }
-
-        // ֵϷ
-        if (state.first == singleMode && snake1.getLife() <= 0) {
-            ended = true;
-        }
-        else if (state.first == pairMode && snake1.getLife() <= 0 && snake2.getLife() <= 0) {
-            ended = true;
-        }
-
-        // ʳʳɼ
-        if (snake1.isEatState()) {
-            int tempScore = foodManager.getScore(newhead1);
-            if (tempScore == 5) {
-                snake1.setSpeedUp(gameTime);
-            }
-            // ״̬ʳ÷ַ
-            score1 += tempScore * (snake1.getIsSpeedUp() ? 2 : 1);
-            foodManager.removeFood(newhead1);
-            snake1.resetEat();
-        }
-        if (state.first == pairMode && snake2.isEatState()) {
-            int tempScore = foodManager.getScore(newhead2);
-            if (tempScore == 5) {
-                snake2.setSpeedUp(gameTime);
-            }
-            // ״̬ʳ÷ַ
-            score2 += tempScore * (snake2.getIsSpeedUp() ? 2 : 1);
-            foodManager.removeFood(newhead2);
-            snake2.resetEat();
-        }
-
-        // ʳûʳˣ
-        if (foodManager.foodEmpty()) {
-            if (!foodManager.generateFood()) {
-                // ͼϷ
-                ended = true;
-            }
-        }
-
-        // Ϸ
-        if (ended) {
-            lastState = state;
-            state.first = gameOver;
-            return;
-        }
-    }
-
-    // ϷȾ
-    void render() {
-        BeginBatchDraw();
-        cleardevice();
-
-        // 1. Ϸͼ
-        wallManager.drawWalls();
-        snake1.draw();
-        if (state.first == pairMode) {
-            snake2.draw();
-        }
-        foodManager.draw();
-
-        // 2.  UI λãҲ 200 أ
-        int uiX = mapWidth * gridSize; // UI ʼ X 
-        int uiWidth = windowWidth - uiX; // ӦΪ 200
-        int panelWidth = uiWidth - 20;  //  10 ر߾
-        int panelHeight = 100;
-        int spacing = 120;
-
-        // 3. ʵʱϷʱ䣨룩
-        int currentTime = gameTime;
-
-        // 4. ıʽȷ drawTextWithBackground ȷ
-        settextstyle(24, 0, _T("SimHei"));
-
-        if (state.first == singleMode) {
-            // === ģʽ UI ===
-            bool isSpeedUp = snake1.getIsSpeedUp();
-
-            TCHAR timeText[64], scoreText[64];
-            _stprintf_s(timeText, _T("̰ʱ:\n%d "), currentTime);
-            if (isSpeedUp)
-                _stprintf_s(scoreText, _T("ħ (WASD):\n%d kg\nǷ:"), score1);
-            else
-                _stprintf_s(scoreText, _T("ħ (WASD):\n%d kg\nǷ:"), score1);
-
-            // ʱ
-            drawTextWithBackground(
-                timeText,
-                uiX + 10, 20,
-                panelWidth, panelHeight,
-                BLACK, WHITE, BLUE, 2, 10
-            );
-
-            // 
-            drawTextWithBackground(
-                scoreText,
-                uiX + 10, 20 + spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, RED, 2, 10
-            );
-
-            drawTextWithBackground(
-                _T(" P ͣ\n Q ˳"),
-                uiX + 10, 20 + 2 * spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, GREEN, 2, 10
-            );
-
-        }
-        else if (state.first == pairMode) {
-            // === ˫ģʽ UI ===
-            bool isSpeedUp1 = snake1.getIsSpeedUp();
-            bool isSpeedUp2 = snake2.getIsSpeedUp();
-
-            TCHAR timeText[64], p1Text[64], p2Text[64], totalText[64];
-            _stprintf_s(timeText, _T("̰ʱ:\n%d "), currentTime);
-            if (isSpeedUp1)
-                _stprintf_s(p1Text, _T("ħ (WASD):\n%d kg\nǷ:"), score1);
-            else
-                _stprintf_s(p1Text, _T("ħ (WASD):\n%d kg\nǷ:"), score1);
-
-            if (isSpeedUp2)
-                _stprintf_s(p2Text, _T(" ():\n%d kg\nǷ:"), score2);
-            else
-                _stprintf_s(p2Text, _T(" ():\n%d kg\nǷ:"), score2);
-            _stprintf_s(totalText, _T("θ:\n%d kg"), score1 + score2);
-
-            // ʱ
-            drawTextWithBackground(
-                timeText,
-                uiX + 10, 20,
-                panelWidth, panelHeight,
-                BLACK, WHITE, BLUE, 2, 10
-            );
-
-            // P1 
-            drawTextWithBackground(
-                p1Text,
-                uiX + 10, 20 + spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, RED, 2, 10
-            );
-
-            // P2 
-            drawTextWithBackground(
-                p2Text,
-                uiX + 10, 20 + 2 * spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, BLUE, 2, 10
-            );
-
-            // ܷ
-            drawTextWithBackground(
-                totalText,
-                uiX + 10, 20 + 3 * spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, RGB(255, 20, 147), 2, 10
-            );
-
-            // ͣʾ
-            drawTextWithBackground(
-                _T(" P ͣ\n Q ˳"),
-                uiX + 10, 20 + 4 * spacing,
-                panelWidth, panelHeight,
-                BLACK, WHITE, GREEN, 2, 10
-            );
-        }
-
-        EndBatchDraw();
-    }
-
-    // зָı
-    vector<basic_string<TCHAR>> splitLines(const TCHAR* text) {
-        std::vector<std::basic_string<TCHAR>> lines;
-        if (!text) return lines;
-
-        std::basic_string<TCHAR> current;
-        const TCHAR* p = text;
-
-        while (*p != _T('\0')) {
-            if (*p == _T('\n')) {
-                lines.push_back(current);
-                current.clear();
-            }
-            else {
-                current.push_back(*p);
-            }
-            p++;
-        }
-        // һУʹ \n
-        lines.push_back(current);
-
-        return lines;
-    }
-
-    // ƴԲǱͱ߿ı
-    void drawTextWithBackground(
-        const TCHAR* text,
-        int x, int y,
-        int width, int height,
-        COLORREF textColor = BLACK,
-        COLORREF bgColor = WHITE,
-        COLORREF borderColor = BLUE,
-        int borderWidth = 5,
-        int cornerRadius = 20,
-        bool centerVertically = true
-    ) {
-        if (!text || *text == _T('\0')) return;
-        settextstyle(30, 0, _T("SimHei"));
-
-        // === 1. ԲǱ + ߿ ===
-        setfillcolor(borderColor);
-        fillroundrect(x, y, x + width, y + height, cornerRadius, cornerRadius);
-
-        setfillcolor(bgColor);
-        fillroundrect(
-            x + borderWidth, y + borderWidth,
-            x + width - borderWidth, y + height - borderWidth,
-            cornerRadius - borderWidth, cornerRadius - borderWidth
-        );
-
-        // === 2. ָı '\n' ָ===
-        std::vector<std::basic_string<TCHAR>> lines = splitLines(text);
-
-        // === 3. 㲼 ===
-        int lineHeight = textheight(_T("")); // ׼и
-        int totalTextHeight = static_cast<int>(lines.size()) * lineHeight;
-        int startY = y + borderWidth;
-        if (centerVertically) {
-            int availableHeight = height - 2 * borderWidth;
-            if (totalTextHeight < availableHeight) {
-                startY += (availableHeight - totalTextHeight) / 2;
-            }
-        }
-
-        // === 4. л ===
-        settextcolor(textColor);
-
-        for (size_t i = 0; i < lines.size(); ++i) {
-            int lineY = startY + static_cast<int>(i) * lineHeight;
-            if (lineY + lineHeight > y + height - borderWidth) break;
-
-            const TCHAR* lineText = lines[i].c_str();
-            int textWidth = textwidth(lineText);
-            int textX = x + borderWidth + (width - 2 * borderWidth - textWidth) / 2;
-            outtextxy(textX, lineY, lineText);
-        }
-    }
-};
-
-// 
-int main() {
-    srand((unsigned)time(0));
-    initgraph(windowWidth, windowHeight);
-    setbkcolor(WHITE);
-    cleardevice();
-
-    Game game;
-    game.run();
-
-    closegraph();
-    return 0;
-}
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <ctime>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <conio.h> 
+#include <graphics.h> 
+#include <windows.h> 
+
+#include "assets.h"
+#include "greedy_ai.h"
+#include "mcts_ai.h"
+#include "records.h"
+#include "replay.h"
+#include "renderer.h"
+#include "simulation.h"
+#include "spsc_queue.h"
+#include "timing.h"
+
+// 提高 Sleep 精度需要 timeBeginPeriod
+#pragma comment(lib, "winmm.lib")
+
+using namespace std;
+
+// 输入处理类 - 处理键盘和鼠标输入
+// 键盘由单独的输入线程轮询，按类型（功能键、玩家1、玩家2）写入各自的无锁队列，游戏线程按类型取出
+class inputHandler : public InputSource {
+private:
+    // 标记左键是否按
+    bool leftButtonDown;
+    // 队列中的按键，附带读入时刻用于统计输入延迟
+    struct bufferedKey {
+        int key;
+        chrono::steady_clock::time_point time;
+    };
+    // 每种按键一个队列，下标为 keyStatus（func/p1/p2），防止玩家在一帧内按下多个键导致的某些键没有识别到
+    SpscQueue<bufferedKey, 64> keyQueues[4];
+    // 队列满而丢掉的按键数
+    atomic<int> droppedKeys;
+    // 玩家方向键从读入到蛇真正转向的延迟统计，可为空
+    TimingStat* latencyStat;
+    // 上一次取出的按键的读入时刻（steady_clock 计数），随转向排进蛇的转向队列
+    long long lastStamp;
+
+    // 输入线程
+    atomic<bool> running;
+    thread pollThread;
+
+    void pushKey(int key, keyStatus type) {
+        if (!keyQueues[type].push({ key, chrono::steady_clock::now() })) {
+            ++droppedKeys;
+        }
+    }
+
+    // 输入线程：约每毫秒读一次键盘
+    void pollLoop() {
+        while (running.load(memory_order_relaxed)) {
+            fetchNewKeys();
+            Sleep(1);
+        }
+    }
+
+public:
+    inputHandler() : leftButtonDown(false), droppedKeys(0), latencyStat(nullptr), lastStamp(0), running(true) {
+        pollThread = thread(&inputHandler::pollLoop, this);
+    }
+
+    ~inputHandler() {
+        running = false;
+        pollThread.join();
+    }
+
+    void setLatencyStat(TimingStat* stat) {
+        latencyStat = stat;
+    }
+
+    int getDroppedKeys() const {
+        return droppedKeys.load();
+    }
+
+    // 更新输入状态
+    void updateMouse() {
+        // 检查是否有鼠标消息
+        if (MouseHit()) {
+            MOUSEMSG msg = GetMouseMsg();
+            if (msg.uMsg == WM_LBUTTONDOWN) {
+                leftButtonDown = true;
+            }
+            else {
+                leftButtonDown = false;
+            }
+        }
+        else {
+            leftButtonDown = false;
+        }
+    }
+
+    // 是否左键按下
+    bool isLeftButtonDown() const {
+        return leftButtonDown;
+    }
+
+    // 获取鼠标实时位置
+    pair<int, int> getMousePos() const {
+        POINT pt;
+        GetCursorPos(&pt);
+        // 将屏幕坐标转换为窗口坐标
+        ScreenToClient(GetHWnd(), &pt);
+        return make_pair(pt.x, pt.y);
+    }
+
+    // 检查鼠标是否悬停在矩形内，用于鼠标悬停在按钮上的检测
+    bool isMouseHoveringInRect(int x1, int y1, int x2, int y2) const {
+        auto pos = getMousePos();
+        return (pos.first >= x1 && pos.first <= x2 && pos.second >= y1 && pos.second <= y2);
+    }
+
+    // 只能在游戏线程调用
+    void clearKeyBuffer() {
+        for (auto& queue : keyQueues) {
+            queue.clear();
+        }
+    }
+
+    // 从系统读取所有可用按键，追加到对应队列尾部，只在输入线程调用
+    void fetchNewKeys() {
+        while (_kbhit()) {
+            int key = _getch();
+            switch (key) {
+            case 'q': case 'Q':case 'p': case 'P':case 27: case 'r':case 'R':case 'b':case 'B':
+                // 直接加入缓冲区
+                pushKey(key, func);
+                continue;
+            }
+
+            switch (key) {
+            case 'W': case 'w':case 'A': case 'a':case 'S': case 's':case 'D': case 'd':
+                // 直接加入缓冲区
+                pushKey(key, p1);
+                continue;
+            }
+
+            if (key == 0xE0) {
+                // 扩展键：再读一次
+                if (_kbhit()) {
+                    int ext = _getch();
+                    switch (ext) {
+                    case 72: key = VK_UP; break;
+                    case 80: key = VK_DOWN; break;
+                    case 75: key = VK_LEFT; break;
+                    case 77: key = VK_RIGHT; break;
+                    default: key = 0; // 未知扩展键
+                    }
+                }
+                else {
+                    key = 0; // 不完整扩展键序列
+                }
+            }
+            else {
+                key = 0; // 非扩展键，忽略
+            }
+            // 此时一定为p2的键
+            if (key != 0) {
+                pushKey(key, p2);
+            }
+        }
+    }
+
+    // 获取最早的一个指定类型的按键，只在游戏线程调用
+    pair<int, keyStatus> getKey(keyStatus keyType) override {
+        bufferedKey key;
+        if (!keyQueues[keyType].pop(key)) {
+            return make_pair(-1, none); // 未找到
+        }
+        lastStamp = key.time.time_since_epoch().count();
+        return make_pair(key.key, keyType);
+    }
+
+    long long keyStamp() const override {
+        return lastStamp;
+    }
+
+    // 方向键可能在转向队列里等过几次移动，延迟统计到转向真正生效为止
+    void turnApplied(int, long long stamp) override {
+        if (latencyStat != nullptr) {
+            chrono::steady_clock::time_point pressed{ chrono::steady_clock::duration(stamp) };
+            latencyStat->add(elapsedMs(pressed, chrono::steady_clock::now()));
+        }
+    }
+};
+
+// 把像素图复制成 EasyX 图像，EasyX 图像缓冲区的像素格式同样是 0xRRGGBB
+void toEasyXImage(const PixelImage& src, IMAGE& dst) {
+    if (src.empty()) {
+        return;
+    }
+    dst.Resize(src.width, src.height);
+    DWORD* buffer = GetImageBuffer(&dst);
+    copy(src.pixels.begin(), src.pixels.end(), buffer);
+}
+
+// EasyX 绘制目标，贴图全部来自同一张图集
+class easyxTarget : public RenderTarget {
+private:
+    IMAGE* atlas;
+    // 每个贴图在图集中的位置，宽为 0 表示缺失
+    vector<AtlasRect> sprites;
+
+    static COLORREF toColor(uint32_t c) {
+        return RGB((c >> 16) & 0xFF, (c >> 8) & 0xFF, c & 0xFF);
+    }
+
+public:
+    easyxTarget() : atlas(nullptr), sprites(spriteCount, AtlasRect{ 0, 0, 0, 0 }) {
+    }
+
+    void setAtlas(IMAGE* atlas_) {
+        atlas = atlas_;
+    }
+
+    void setSprite(int sprite, const AtlasRect& rect) {
+        sprites[sprite] = rect;
+    }
+
+    void fillRect(int x, int y, int w, int h, uint32_t color) override {
+        setfillcolor(toColor(color));
+        // EasyX 的矩形包含右边和下边
+        solidrectangle(x, y, x + w - 1, y + h - 1);
+    }
+
+    // 同色矩形只设置一次填充色
+    void fillRects(const DrawRect* rects, size_t count, uint32_t color) override {
+        setfillcolor(toColor(color));
+        for (size_t i = 0; i < count; ++i) {
+            solidrectangle(rects[i].x, rects[i].y, rects[i].x + rects[i].w - 1, rects[i].y + rects[i].h - 1);
+        }
+    }
+
+    void fillCircle(int cx, int cy, int r, uint32_t color) override {
+        setfillcolor(toColor(color));
+        solidcircle(cx, cy, r);
+    }
+
+    bool drawSprite(int x, int y, int sprite) override {
+        const AtlasRect& r = sprites[sprite];
+        if (atlas == nullptr || r.w == 0) {
+            return false;
+        }
+        putimage(x, y, r.w, r.h, atlas, r.x, r.y);
+        return true;
+    }
+
+    bool hasSprite(int sprite) const override {
+        return atlas != nullptr && sprites[sprite].w > 0;
+    }
+};
+
+// 面板缓存：把圆角文本框预先画到离屏图像里，文字和样式不变时直接贴图，不再重新排版
+// 圆角外需要透出底下的背景，因此每个面板存一张遮罩（框内黑、框外白）和一张内容图（框外黑），
+// 先用遮罩 SRCAND 挖空，再用内容图 SRCPAINT 填入
+class panelCache {
+private:
+    struct panel {
+        basic_string<TCHAR> text;
+        int width, height;
+        COLORREF textColor, bgColor, borderColor;
+        int borderWidth, cornerRadius;
+        bool centerVertically;
+        IMAGE image;
+        IMAGE mask;
+    };
+
+    // 按内容哈希索引，哈希相同再逐项比较
+    unordered_map<uint64_t, panel*> panels;
+    // 缓存上限，超过后整体清空（分数、时间面板会不断产生新内容）
+    static const size_t maxPanels = 64;
+
+    // 字形宽度缓存，面板字体固定为 30 号黑体；-1 表示尚未测量
+    int asciiWidth[128];
+    unordered_map<TCHAR, int> wideWidth;
+    int lineHeight;
+    // 排版时复用的单行缓冲
+    basic_string<TCHAR> lineText;
+
+    static uint64_t mix(uint64_t h, uint64_t v) {
+        // FNV-1a
+        return (h ^ v) * 1099511628211ULL;
+    }
+
+    int glyphWidth(TCHAR c) {
+        unsigned code = static_cast<unsigned>(c);
+        if (code < 128) {
+            if (asciiWidth[code] < 0) {
+                asciiWidth[code] = textwidth(c);
+            }
+            return asciiWidth[code];
+        }
+        auto it = wideWidth.find(c);
+        if (it == wideWidth.end()) {
+            it = wideWidth.insert(make_pair(c, textwidth(c))).first;
+        }
+        return it->second;
+    }
+
+    void clear() {
+        for (auto& item : panels) {
+            delete item.second;
+        }
+        panels.clear();
+    }
+
+    // 把面板画到 p.image / p.mask，坐标以面板左上角为原点
+    void rasterize(panel& p) {
+        COLORREF bk = getbkcolor();
+        int bkMode = getbkmode();
+        COLORREF line = getlinecolor();
+        int w = p.width, h = p.height;
+
+        // 遮罩
+        p.mask.Resize(w + 1, h + 1);
+        SetWorkingImage(&p.mask);
+        setbkcolor(WHITE);
+        cleardevice();
+        setlinecolor(BLACK);
+        setfillcolor(BLACK);
+        fillroundrect(0, 0, w, h, p.cornerRadius, p.cornerRadius);
+
+        // 内容：圆角背景 + 边框
+        p.image.Resize(w + 1, h + 1);
+        SetWorkingImage(&p.image);
+        setbkcolor(BLACK);
+        cleardevice();
+        setbkcolor(bk);
+        setbkmode(bkMode);
+        setlinecolor(line);
+        settextstyle(30, 0, _T("SimHei"));
+
+        setfillcolor(p.borderColor);
+        fillroundrect(0, 0, w, h, p.cornerRadius, p.cornerRadius);
+        setfillcolor(p.bgColor);
+        fillroundrect(p.borderWidth, p.borderWidth, w - p.borderWidth, h - p.borderWidth,
+            p.cornerRadius - p.borderWidth, p.cornerRadius - p.borderWidth);
+
+        // 按 '\n' 分行，居中绘制
+        if (lineHeight < 0) {
+            lineHeight = textheight(_T("国")); // 基准行高
+        }
+        int lineCount = 1;
+        for (TCHAR c : p.text) {
+            lineCount += (c == _T('\n'));
+        }
+        int startY = p.borderWidth;
+        if (p.centerVertically) {
+            int availableHeight = h - 2 * p.borderWidth;
+            if (lineCount * lineHeight < availableHeight) {
+                startY += (availableHeight - lineCount * lineHeight) / 2;
+            }
+        }
+
+        settextcolor(p.textColor);
+        size_t begin = 0;
+        for (int i = 0; i < lineCount; ++i) {
+            size_t end = p.text.find(_T('\n'), begin);
+            if (end == basic_string<TCHAR>::npos) {
+                end = p.text.size();
+            }
+            int lineY = startY + i * lineHeight;
+            if (lineY + lineHeight > h - p.borderWidth) break;
+
+            lineText.assign(p.text, begin, end - begin);
+            int textWidth = 0;
+            for (TCHAR c : lineText) {
+                textWidth += glyphWidth(c);
+            }
+            int textX = p.borderWidth + (w - 2 * p.borderWidth - textWidth) / 2;
+            outtextxy(textX, lineY, lineText.c_str());
+            begin = end + 1;
+        }
+
+        SetWorkingImage(NULL);
+    }
+
+public:
+    panelCache() : lineHeight(-1) {
+        for (int& w : asciiWidth) {
+            w = -1;
+        }
+    }
+
+    ~panelCache() {
+        clear();
+    }
+
+    // 绘制面板，参数含义与 drawTextWithBackground 相同
+    void draw(const TCHAR* text, int x, int y, int width, int height,
+        COLORREF textColor, COLORREF bgColor, COLORREF borderColor,
+        int borderWidth, int cornerRadius, bool centerVertically) {
+        uint64_t key = 14695981039346656037ULL;
+        size_t length = 0;
+        for (const TCHAR* c = text; *c != _T('\0'); ++c, ++length) {
+            key = mix(key, static_cast<uint64_t>(*c));
+        }
+        key = mix(key, static_cast<uint64_t>(width) << 32 | static_cast<uint32_t>(height));
+        key = mix(key, static_cast<uint64_t>(textColor) << 32 | bgColor);
+        key = mix(key, static_cast<uint64_t>(borderColor) << 32 | static_cast<uint32_t>(borderWidth));
+        key = mix(key, static_cast<uint64_t>(cornerRadius) << 1 | (centerVertically ? 1 : 0));
+
+        auto it = panels.find(key);
+        panel* p = (it == panels.end()) ? nullptr : it->second;
+        bool hit = p != nullptr && p->width == width && p->height == height
+            && p->textColor == textColor && p->bgColor == bgColor && p->borderColor == borderColor
+            && p->borderWidth == borderWidth && p->cornerRadius == cornerRadius
+            && p->centerVertically == centerVertically && p->text.compare(0, p->text.size(), text, length) == 0
+            && p->text.size() == length;
+        if (!hit) {
+            if (p == nullptr) {
+                if (panels.size() >= maxPanels) {
+                    clear();
+                }
+                p = new panel;
+                panels[key] = p;
+            }
+            p->text.assign(text, length);
+            p->width = width;
+            p->height = height;
+            p->textColor = textColor;
+            p->bgColor = bgColor;
+            p->borderColor = borderColor;
+            p->borderWidth = borderWidth;
+            p->cornerRadius = cornerRadius;
+            p->centerVertically = centerVertically;
+            rasterize(*p);
+        }
+
+        putimage(x, y, &p->mask, SRCAND);
+        putimage(x, y, &p->image, SRCPAINT);
+    }
+};
+
+// 游戏主逻辑类
+class Game {
+private:
+    // 游戏规则引擎，包含地图、蛇、食物和墙
+    Simulation sim;
+    // 为每一局派生随机种子
+    Rng seedSource;
+    // 录像器，每局结束后把录像写入 replays 目录
+    ReplayRecorder recorder;
+
+    // 游戏时间（毫秒），由规则引擎按帧数换算，暂停期间不计
+    int gameTimeMs;
+    // 帧耗时与输入延迟统计，每局结束时输出
+    FrameStats frameStats;
+    // 暂停返回后需要重置帧时钟，否则暂停的时长会被当作需要追赶的逻辑帧
+    bool clockReset;
+
+    // 增量渲染：棋盘只重绘变化的格子，右侧面板只在显示的数值变化时重绘
+    easyxTarget screen;
+    BoardRenderer boardRenderer;
+    // 圆角文本框缓存
+    panelCache panels;
+    // 上次绘制面板时的数值，panelValid 为 false 时下一帧必定重绘
+    bool panelValid;
+    int shownTime, shownScore1, shownScore2;
+    bool shownSpeedUp1, shownSpeedUp2;
+    const AIInput* shownBot;
+
+    // 游戏状态管理
+    pair<GameState, GameVersion> lastState, state;
+
+    // 输入处理器
+    inputHandler inputHandler;
+    // 双人模式下按 B 由电脑接管玩家2，玩家1 的按键仍来自键盘；依次切换 贪心 -> 树搜索 -> 关闭
+    ThreadPool aiPool;
+    GreedyAI greedyBot;
+    MctsAI mctsBot;
+    AIInput* bot;
+
+    // 游戏历史记录管理
+    int score1, score2;
+    int winner;
+    RecordManager recordManager;
+
+    // 图片资源：蛇头和食物打包在图集里，背景图单独存放
+    AssetManager assets;
+    IMAGE imgAtlas;
+    vector<IMAGE> imgBackgrounds;
+
+public:
+    // 构造函数
+    Game() : seedSource(static_cast<uint64_t>(time(0))), gameTimeMs(0), clockReset(false), panelValid(false),
+        shownTime(0), shownScore1(0), shownScore2(0), shownSpeedUp1(false), shownSpeedUp2(false), shownBot(nullptr),
+        greedyBot(sim, 2, &inputHandler), mctsBot(sim, 2, aiPool, &inputHandler, 4000), bot(nullptr), score1(0), score2(0), winner(0) {
+        state = lastState = make_pair(menu, selecting);
+        inputHandler.setLatencyStat(&frameStats.inputLatency);
+
+        loadAssets();
+        sim.setDirtyTracking(true);
+    }
+
+    // 启动时一次性并行解码 pictures 目录下的全部图片
+    void loadAssets() {
+        static const char* spriteFiles[spriteCount] = {
+            "snake_head1.png", "snake_head2.png",
+            "food1.png", "food2.png", "food3.png", "food4.png", "food5.png"
+        };
+        static const char* backgroundFiles[] = {
+            "menuBg.png", "menuBg1.png", "menuBg2.png", "menuBg3.png", "menuBg4.png",
+            "selectBg1.png", "selectBg2.png", "selectBg3.png", "selectBg4.png"
+        };
+        // 句柄与 SpriteId 一一对应，背景图紧随其后
+        for (const char* file : spriteFiles) {
+            assets.add(file, assetSprite);
+        }
+        for (const char* file : backgroundFiles) {
+            assets.add(file, assetBackground);
+        }
+
+        ThreadPool loader;
+        if (assets.loadAll("pictures", loader) > 0) {
+            for (const auto& file : assets.getFailed()) {
+                cerr << "Failed to load " << file << endl;
+            }
+        }
+        cerr << "Loaded assets in " << assets.getLoadMs() << " ms" << endl;
+
+        toEasyXImage(assets.getAtlas(), imgAtlas);
+        screen.setAtlas(&imgAtlas);
+        for (int i = 0; i < spriteCount; ++i) {
+            if (assets.isLoaded(i)) {
+                screen.setSprite(i, assets.getRect(i));
+            }
+        }
+
+        // 加载失败的背景保持空图，putimage 不会画任何东西
+        imgBackgrounds.resize(sizeof(backgroundFiles) / sizeof(backgroundFiles[0]));
+        for (size_t i = 0; i < imgBackgrounds.size(); ++i) {
+            toEasyXImage(assets.getImage(spriteCount + static_cast<int>(i)), imgBackgrounds[i]);
+        }
+    }
+
+    // 游戏主循环
+    void run() {
+        while (true) {
+            inputHandler.clearKeyBuffer();
+            switch (state.first) {
+            case menu:
+                handleMenu();
+                break;
+            case viewRecords:
+                handleViewRecords();
+                break;
+            case singleMode:
+            case pairMode:
+                if (state.second == selecting) {
+                    handleSelectVersion();
+                }
+                else {
+                    init();
+                    playLoop();
+                }
+                break;
+
+            case gameOver:
+                handleGameOver();
+                break;
+            default:
+                exit(1);
+            }
+        }
+    }
+
+    // 是否处于对局中
+    bool isPlaying() const {
+        return (state.first == singleMode || state.first == pairMode) && state.second != selecting;
+    }
+
+    // 对局循环：逻辑帧固定 frameInterval 毫秒推进，渲染按 renderInterval 限速，两者互不影响
+    void playLoop() {
+        typedef chrono::steady_clock clock;
+        FixedStep stepper(frameInterval, maxTicksPerFrame);
+        frameStats.reset();
+        clockReset = false;
+
+        clock::time_point last = clock::now();
+        clock::time_point lastRender = last - chrono::milliseconds(renderInterval);
+        while (isPlaying()) {
+            clock::time_point now = clock::now();
+            int dropped = 0;
+            int steps = stepper.advance(elapsedMs(last, now), dropped);
+            last = now;
+            frameStats.droppedTicks += dropped;
+
+            // 渲染慢了就在这里连续追赶多个逻辑帧
+            for (int i = 0; i < steps && isPlaying() && !clockReset; ++i) {
+                clock::time_point begin = clock::now();
+                update();
+                frameStats.update.add(elapsedMs(begin, clock::now()));
+                ++frameStats.ticks;
+            }
+            if (clockReset) {
+                clockReset = false;
+                stepper.reset();
+                last = clock::now();
+            }
+            if (!isPlaying()) {
+                break;
+            }
+
+            // 到了渲染间隔才画一帧
+            now = clock::now();
+            if (elapsedMs(lastRender, now) >= renderInterval) {
+                lastRender = now;
+                render();
+                frameStats.render.add(elapsedMs(now, clock::now()));
+                ++frameStats.frames;
+            }
+
+            // 睡到下一个逻辑帧或下一次渲染，取较早者
+            double wait = min(stepper.untilNextStep(), renderInterval - elapsedMs(lastRender, clock::now()));
+            if (wait >= 1) {
+                Sleep(static_cast<DWORD>(wait));
+            }
+        }
+        reportFrameStats();
+    }
+
+    // 输出本局的帧耗时和输入延迟
+    void reportFrameStats() const {
+        cerr << "ticks " << frameStats.ticks << " (dropped " << frameStats.droppedTicks << ")"
+            << ", frames " << frameStats.frames << endl;
+        cerr << "update avg " << frameStats.update.average() << " ms, max " << frameStats.update.maxValue << " ms" << endl;
+        cerr << "render avg " << frameStats.render.average() << " ms, max " << frameStats.render.maxValue << " ms" << endl;
+        cerr << "input latency avg " << frameStats.inputLatency.average() << " ms, max "
+            << frameStats.inputLatency.maxValue << " ms over " << frameStats.inputLatency.count << " keys"
+            << ", " << inputHandler.getDroppedKeys() << " dropped" << endl;
+    }
+
+    // 菜单处理函数
+    void handleMenu() {
+        // 按钮尺寸和位置
+        const int btnW = 400;
+        const int btnH = 100;
+        const int centerX = windowWidth * 3 / 4;
+        const int startY = 200;
+
+        while (state.first == menu) {
+            inputHandler.clearKeyBuffer();
+            inputHandler.updateMouse();
+            BeginBatchDraw();
+            cleardevice();
+
+            putimage(0, 0, &imgBackgrounds[0]);
+
+            // 标题（也可用文本框）
+            settextstyle(48, 0, _T("SimHei"));
+            settextcolor(RED);
+            outtextxy(centerX - 200, 80, _T("欢迎来到贪吃荣耀"));
+
+            const TCHAR* labels[] = {
+                _T("让我独享经验！"),
+                _T("魔丸 & 灵珠"),
+                _T("历史最大胃袋"),
+                _T("下线吃焖子")
+            };
+
+            int y = startY;
+            for (int i = 0; i < 4; ++i) {
+                int x = centerX - btnW / 2;
+                COLORREF textCol = BLACK;
+
+                // 悬停高亮
+                if (inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
+                    textCol = RED;    // 悬停文字色
+                    clearrectangle(0, 0, 720, 720);
+                    putimage(0, 0, &imgBackgrounds[1 + i % 4]); // 更换背景
+                }
+
+                drawTextWithBackground(labels[i], x, y, btnW, btnH, textCol);
+
+                // 点击检测（仍用矩形区域）
+                if (inputHandler.isLeftButtonDown() &&
+                    inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
+                    if (i == 0) {
+                        state = make_pair(singleMode, selecting);
+                    }
+                    else if (i == 1) {
+                        state = make_pair(pairMode, selecting);
+                    }
+                    else if (i == 2) {
+                        state = make_pair(viewRecords, selecting);
+                    }
+                    else if (i == 3) {
+                        exit(0);
+                    }
+                }
+
+                y += 120;
+            }
+
+            EndBatchDraw();
+            Sleep(10);
+        }
+    }
+
+    // 版本选择处理函数
+    void handleSelectVersion() {
+        // 按钮尺寸和位置
+        const int btnW = 400;
+        const int btnH = 100;
+        const int centerX = windowWidth * 3 / 4;
+        const int startY = 200;
+
+        while (state.second == selecting && (state.first == singleMode || state.first == pairMode)) {
+            inputHandler.clearKeyBuffer();
+            inputHandler.updateMouse();
+            BeginBatchDraw();
+
+            cleardevice();
+
+            if (state.first == singleMode) {
+                putimage(0, 0, &imgBackgrounds[1]);
+            }
+            else {
+                putimage(0, 0, &imgBackgrounds[2]);
+            }
+
+            // 标题
+            settextstyle(48, 0, _T("SimHei"));
+            settextcolor(RED);
+            outtextxy(centerX - 200, 80, _T("请选择你的对局难度"));
+
+            const TCHAR* labels[] = {
+                _T("金牌战士(入门版)"),
+                _T("金牌射手(进阶版)"),
+                _T("金牌坦克(高级版)"),
+                _T("返回")
+            };
+
+            int y = startY;
+            for (int i = 0; i < 4; ++i) {
+                int x = centerX - btnW / 2;
+                COLORREF textCol = BLACK;
+
+                // 悬停高亮
+                if (inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
+                    textCol = RED;    // 悬停文字色
+                    if (i != 3) {
+                        clearrectangle(0, 0, 720, 720);
+                        putimage(0, 0, &imgBackgrounds[5 + i]); // 更换背景
+                    }
+                }
+
+                drawTextWithBackground(labels[i], x, y, btnW, btnH, textCol);
+
+                // 点击检测（仍用矩形区域）
+                if (inputHandler.isLeftButtonDown() &&
+                    inputHandler.isMouseHoveringInRect(x, y, x + btnW, y + btnH)) {
+                    if (i == 0) { state.second = beginner; }
+                    else if (i == 1) { state.second = advanced; }
+                    else if (i == 2) { state.second = expert; }
+                    else if (i == 3) {
+                        state = make_pair(menu, selecting);
+                        return;
+                    }
+                }
+
+                y += 120; // 增大间距
+            }
+
+            // 退出按键检测
+            auto key = inputHandler.getKey(func);
+            if (key.first == 'q' || key.first == 'Q' || key.first == 27) {
+                state = make_pair(menu, selecting);
+            }
+
+            EndBatchDraw();
+            Sleep(10);
+        }
+    }
+
+    // 查看记录处理函数
+    void handleViewRecords() {
+        // 按钮尺寸和位置
+        const int btnW = 600;
+        const int btnH = 100;
+        const int spacingY = 80;
+        const int startX = windowWidth / 2 - btnW / 2;
+        const int startY = 100;
+
+        while (state.first == viewRecords) {
+            inputHandler.clearKeyBuffer();
+            inputHandler.updateMouse();
+            BeginBatchDraw();
+
+            // 清屏 + 绘制背景
+            cleardevice();
+
+            // 标题
+            settextstyle(50, 0, _T("SimHei"));
+            settextcolor(RED);
+            outtextxy(startX + 150, 30, _T("历史最大胃袋"));
+
+            // 定义版本名称（中文）
+            const TCHAR* versionNames[2][3] = {
+                {_T("让我独享经验·金牌战士(入门版)"), _T("让我独享经验·金牌射手(进阶版)"), _T("让我独享经验·金牌坦克(高级版)")},
+                {_T("灵珠 & 魔丸·金牌战士(入门版)"), _T("灵珠 & 魔丸·金牌射手(进阶版)"), _T("灵珠 & 魔丸·金牌坦克(高级版)")}
+            };
+
+            for (int i = 0; i < 3; ++i) {
+                // 单人记录
+                info singleInfo = recordManager.getSingleBestInfo(i);
+                TCHAR singleRecordText[256];
+                _stprintf_s(singleRecordText, 256, _T("%s\n最高分: %d 分\n时间: %d.%02d 秒"),
+                    versionNames[0][i], singleInfo.score1, singleInfo.timeMs / 1000, singleInfo.timeMs % 1000 / 10);
+                drawTextWithBackground(singleRecordText, startX - 400, startY + i * 2 * spacingY, btnW, btnH);
+
+                // 双人记录
+                info pairInfo = recordManager.getPairBestInfo(i);
+                TCHAR pairRecordText[256];
+                _stprintf_s(pairRecordText, 256, _T("%s\n最高分: %d 分\n时间: %d.%02d 秒"),
+                    versionNames[1][i], pairInfo.score1 + pairInfo.score2, pairInfo.timeMs / 1000, pairInfo.timeMs % 1000 / 10);
+                drawTextWithBackground(pairRecordText, startX + 400, startY + i * 2 * spacingY, btnW, btnH);
+            }
+
+            int returnBtnX = startX;
+            int returnBtnY = startY + 6 * spacingY;
+            drawTextWithBackground(_T("返 回"), returnBtnX, returnBtnY, btnW, btnH, BLACK, WHITE, RED, 3, 15);
+
+            if (inputHandler.isMouseHoveringInRect(returnBtnX, returnBtnY, returnBtnX + btnW, returnBtnY + btnH)) {
+                drawTextWithBackground(_T("返 回"), returnBtnX, returnBtnY, btnW, btnH, RED, WHITE, RED, 3, 15);
+            }
+
+            EndBatchDraw();
+
+            // 点击检测
+            if (inputHandler.isLeftButtonDown()) {
+                // 检测返回按钮
+                if (inputHandler.isMouseHoveringInRect(returnBtnX, returnBtnY, returnBtnX + btnW, returnBtnY + btnH)) {
+                    state = make_pair(menu, selecting);
+                }
+            }
+            auto key = inputHandler.getKey(func);
+            if (key.first == 'q' || key.first == 'Q' || key.first == 27) {
+                state = make_pair(menu, selecting);
+            }
+            Sleep(10);
+        }
+    }
+
+    // 暂停处理函数
+    void handlePause() {
+        // 按钮尺寸和位置
+        const int btnW = 400;
+        const int btnH = 200;
+        const int spacingY = 150;
+        const int startX = windowWidth / 2 - btnW / 2;
+        const int startY = 400;
+
+        bool isPaused = true;
+        // 返回对局后从当前时刻重新计时，暂停界面清过屏，整屏重绘
+        clockReset = true;
+        invalidateScreen();
+
+        while (isPaused) {
+            inputHandler.clearKeyBuffer();
+            inputHandler.updateMouse();
+            BeginBatchDraw();
+
+            // 清屏
+            cleardevice();
+
+            // 绘制文字
+            settextstyle(50, 0, _T("SimHei"));
+            drawTextWithBackground(_T("按 P 回到餐桌\n按 Q 曼巴OUT"), startX - 200, startY - 250, btnW + 400, btnH - 50, RED, WHITE, BLUE, 3, 20);
+            drawTextWithBackground(_T("回到餐桌"), startX - 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
+            drawTextWithBackground(_T("曼巴OUT"), startX + 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
+
+            if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
+                drawTextWithBackground(_T("回到餐桌"), startX - 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
+            }
+            else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
+                drawTextWithBackground(_T("曼巴OUT"), startX + 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
+            }
+
+            EndBatchDraw();
+
+            // 点击检测
+            if (inputHandler.isLeftButtonDown()) {
+                // 检测返回按钮
+                if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
+                    state = lastState;
+                    return;
+                }
+                else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
+                    state.first = gameOver;
+                    return;
+                }
+            }
+
+            // 键盘检测
+            auto pauseKey = inputHandler.getKey(func);
+            if (pauseKey.first == 'p' || pauseKey.first == 'P') {
+                inputHandler.clearKeyBuffer();
+                isPaused = false;
+                return;
+            }
+            else if (pauseKey.first == 'q' || pauseKey.first == 'Q' || pauseKey.first == 27) { // 在暂停时也处理 Q
+                inputHandler.clearKeyBuffer();
+                state.first = gameOver;
+                return;
+            }
+            Sleep(10);
+        }
+    }
+
+    // 游戏结束处理函数
+    void handleGameOver() {
+        // 保存本局录像
+        saveReplay();
+
+        // 先更新历史记录
+        if (lastState.first == singleMode) {
+            recordManager.updateSingleInfo(lastState.second - beginner, info(gameTimeMs, score1));
+        }
+        else if (lastState.first == pairMode) {
+            recordManager.updatePairInfo(lastState.second - beginner, info(gameTimeMs, score1, score2));
+        }
+
+        // 按钮尺寸和位置
+        const int btnW = 400;
+        const int btnH = 200;
+        const int spacingY = 150;
+        const int startX = windowWidth / 2 - btnW / 2;
+        const int startY = 400;
+
+        while (state.first == gameOver) {
+            inputHandler.clearKeyBuffer();
+            inputHandler.updateMouse();
+            BeginBatchDraw();
+
+            // 清屏
+            cleardevice();
+
+            // 绘制文字
+            settextstyle(50, 0, _T("SimHei"));
+
+            TCHAR gameOverText[256];
+            if (lastState.first == singleMode) {
+                _stprintf_s(gameOverText, 256, _T("让我独享经验！\n增重: %d kg\n时间: %d.%02d 秒"),
+                    score1, gameTimeMs / 1000, gameTimeMs % 1000 / 10);
+            }
+            else if (lastState.first == pairMode) {
+                _stprintf_s(gameOverText, 256,
+                    _T("魔丸 & 灵珠\n魔丸增重: %d kg\n灵珠增重: %d kg\n总增重: %d kg\n时间: %d.%02d 秒"),
+                    score1, score2, score1 + score2, gameTimeMs / 1000, gameTimeMs % 1000 / 10);
+
+            }
+            drawTextWithBackground(gameOverText, startX - 200, startY - 250, btnW + 400, btnH, RED, WHITE, BLUE, 3, 20);
+            drawTextWithBackground(_T("再来一顿"), startX - 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
+            drawTextWithBackground(_T("曼巴OUT"), startX + 200, startY, btnW, btnH, BLACK, WHITE, BLUE, 3, 15);
+
+            if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
+                drawTextWithBackground(_T("再来一顿"), startX - 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
+            }
+            else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
+                drawTextWithBackground(_T("曼巴OUT"), startX + 200, startY, btnW, btnH, RED, WHITE, BLUE, 3, 15);
+            }
+
+            EndBatchDraw();
+
+            // 点击检测
+            if (inputHandler.isLeftButtonDown()) {
+                // 检测返回按钮
+                if (inputHandler.isMouseHoveringInRect(startX - 200, startY, startX + btnW - 200, startY + btnH)) {
+                    state = make_pair(lastState.first, lastState.second);
+                    init();
+                    return;
+                }
+                else if (inputHandler.isMouseHoveringInRect(startX + 200, startY, startX + btnW + 200, startY + btnH)) {
+                    state = make_pair(lastState.first, selecting);
+                    return;
+                }
+            }
+
+            // 键盘检测
+            auto pauseKey = inputHandler.getKey(func);
+            if (pauseKey.first == 'r' || pauseKey.first == 'R') {
+                inputHandler.clearKeyBuffer();
+                state = make_pair(lastState.first, lastState.second);
+                return;
+            }
+            else if (pauseKey.first == 'q' || pauseKey.first == 'Q' || pauseKey.first == 27) { // 在暂停时也处理 Q
+                inputHandler.clearKeyBuffer();
+                state = make_pair(lastState.first, selecting);
+                return;
+            }
+            Sleep(10);
+        }
+    }
+
+    // 游戏初始化函数
+    void init() {
+        score1 = score2 = 0;
+        gameTimeMs = 0;
+
+        sim.init(state.first, state.second, seedSource.next64());
+        recorder.begin(sim);
+        invalidateScreen();
+
+        inputHandler.clearKeyBuffer();
+    }
+
+    // 下一次渲染整屏重绘（其他界面清过屏之后）
+    void invalidateScreen() {
+        boardRenderer.invalidate();
+        panelValid = false;
+    }
+
+    // 结束录像并写入 replays/年月日_时分秒.snkr
+    void saveReplay() {
+        if (!recorder.isActive()) {
+            return;
+        }
+        recorder.finish(sim);
+
+        CreateDirectoryA("replays", NULL);
+        time_t now = time(0);
+        tm local;
+        localtime_s(&local, &now);
+        char path[64];
+        strftime(path, sizeof(path), "replays/%Y%m%d_%H%M%S.snkr", &local);
+        if (!recorder.getReplay().save(path)) {
+            cerr << "Failed to save replay " << path << endl;
+        }
+    }
+
+    // 功能键处理函数
+    void handleKey() {
+        pair<int, keyStatus> key = inputHandler.getKey(func);
+        lastState = state;
+        if (key.first == 'p' || key.first == 'P') {
+            inputHandler.clearKeyBuffer();
+            handlePause();
+            return;
+        }
+        else if (key.first == 27 || key.first == 'q' || key.first == 'Q') {
+            inputHandler.clearKeyBuffer();
+            state.first = gameOver;
+            return;
+        }
+        else if ((key.first == 'b' || key.first == 'B') && state.first == pairMode) {
+            if (bot == nullptr) {
+                bot = &greedyBot;
+            }
+            else if (bot == &greedyBot) {
+                bot = &mctsBot;
+            }
+            else {
+                bot = nullptr;
+            }
+            return;
+        }
+    }
+
+    // 游戏更新函数
+    void update() {
+        // 如果游戏已结束，直接返回
+        if (state.first == gameOver) {
+            return;
+        }
+
+        // 功能键（暂停/退出/电脑接管），玩家方向键由规则引擎在蛇移动时读取
+        handleKey();
+        if (state.first != singleMode && state.first != pairMode) {
+            return;
+        }
+
+        if (bot && state.first == pairMode) {
+            sim.update(*bot);
+        }
+        else {
+            sim.update(inputHandler);
+        }
+        recorder.record(sim);
+
+        gameTimeMs = static_cast<int>(sim.getGameTimeMs());
+        score1 = sim.getScore1();
+        score2 = sim.getScore2();
+
+        // 游戏结束
+        if (sim.isEnded()) {
+            lastState = state;
+            state.first = gameOver;
+            return;
+        }
+    }
+
+    // 游戏渲染函数
+    void render() {
+        BeginBatchDraw();
+
+        // 1. 绘制游戏地图内容，只重绘变化的格子
+        boardRenderer.draw(sim, screen);
+
+        // 2. 面板显示的数值都没变就不重绘
+        bool isSpeedUp1 = sim.isSpeedUp(1);
+        bool isSpeedUp2 = state.first == pairMode && sim.isSpeedUp(2);
+        // 面板时间显示到 0.1 秒
+        int panelTime = gameTimeMs / 100;
+        if (panelValid && shownTime == panelTime && shownScore1 == score1 && shownScore2 == score2
+            && shownSpeedUp1 == isSpeedUp1 && shownSpeedUp2 == isSpeedUp2 && shownBot == bot) {
+            EndBatchDraw();
+            return;
+        }
+        panelValid = true;
+        shownTime = panelTime;
+        shownScore1 = score1;
+        shownScore2 = score2;
+        shownSpeedUp1 = isSpeedUp1;
+        shownSpeedUp2 = isSpeedUp2;
+        shownBot = bot;
+
+        // 3. 计算 UI 区域位置（右侧 200 像素）
+        int uiX = mapWidth * gridSize; // UI 起始 X 坐标
+        int uiWidth = windowWidth - uiX; // 应为 200
+        int panelWidth = uiWidth - 20;  // 留出 10 像素边距
+        int panelHeight = 100;
+        int spacing = 120;
+        screen.fillRect(uiX, 0, uiWidth, windowHeight, colorBackground);
+
+        // 4. 游戏时间（0.1 秒）
+        int currentTime = panelTime;
+
+        // 5. 设置文本样式（确保 drawTextWithBackground 能正确测量）
+        settextstyle(24, 0, _T("SimHei"));
+
+        if (state.first == singleMode) {
+            // === 单人模式 UI ===
+            bool isSpeedUp = isSpeedUp1;
+
+            TCHAR timeText[64], scoreText[64];
+            _stprintf_s(timeText, _T("贪吃时间:\n%d.%d 秒"), currentTime / 10, currentTime % 10);
+            if (isSpeedUp)
+                _stprintf_s(scoreText, _T("魔丸 (WASD):\n%d kg\n是否加速:是"), score1);
+            else
+                _stprintf_s(scoreText, _T("魔丸 (WASD):\n%d kg\n是否加速:否"), score1);
+
+            // 时间面板
+            drawTextWithBackground(
+                timeText,
+                uiX + 10, 20,
+                panelWidth, panelHeight,
+                BLACK, WHITE, BLUE, 2, 10
+            );
+
+            // 分数面板
+            drawTextWithBackground(
+                scoreText,
+                uiX + 10, 20 + spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, RED, 2, 10
+            );
+
+            drawTextWithBackground(
+                _T("按 P 暂停\n按 Q 退出"),
+                uiX + 10, 20 + 2 * spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, GREEN, 2, 10
+            );
+
+        }
+        else if (state.first == pairMode) {
+            // === 双人模式 UI ===
+            TCHAR timeText[64], p1Text[64], p2Text[64], totalText[64];
+            _stprintf_s(timeText, _T("贪吃时间:\n%d.%d 秒"), currentTime / 10, currentTime % 10);
+            if (isSpeedUp1)
+                _stprintf_s(p1Text, _T("魔丸 (WASD):\n%d kg\n是否加速:是"), score1);
+            else
+                _stprintf_s(p1Text, _T("魔丸 (WASD):\n%d kg\n是否加速:否"), score1);
+
+            const TCHAR* p2Name = (bot == &mctsBot) ? _T("灵珠 (搜索)") : bot ? _T("灵珠 (电脑)") : _T("灵珠 (方向键)");
+            if (isSpeedUp2)
+                _stprintf_s(p2Text, _T("%s:\n%d kg\n是否加速:是"), p2Name, score2);
+            else
+                _stprintf_s(p2Text, _T("%s:\n%d kg\n是否加速:否"), p2Name, score2);
+            _stprintf_s(totalText, _T("总胃袋:\n%d kg"), score1 + score2);
+
+            // 时间面板
+            drawTextWithBackground(
+                timeText,
+                uiX + 10, 20,
+                panelWidth, panelHeight,
+                BLACK, WHITE, BLUE, 2, 10
+            );
+
+            // P1 面板
+            drawTextWithBackground(
+                p1Text,
+                uiX + 10, 20 + spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, RED, 2, 10
+            );
+
+            // P2 面板
+            drawTextWithBackground(
+                p2Text,
+                uiX + 10, 20 + 2 * spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, BLUE, 2, 10
+            );
+
+            // 总分面板
+            drawTextWithBackground(
+                totalText,
+                uiX + 10, 20 + 3 * spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, RGB(255, 20, 147), 2, 10
+            );
+
+            // 暂停提示
+            drawTextWithBackground(
+                _T("按 P 暂停\n按 Q 退出\n按 B 电脑接管"),
+                uiX + 10, 20 + 4 * spacing,
+                panelWidth, panelHeight,
+                BLACK, WHITE, GREEN, 2, 10
+            );
+        }
+
+        EndBatchDraw();
+    }
+
+    // 辅助函数：绘制带圆角背景和边框的文本框（经面板缓存，内容不变时直接贴图）
+    void drawTextWithBackground(
+        const TCHAR* text,
+        int x, int y,
+        int width, int height,
+        COLORREF textColor = BLACK,
+        COLORREF bgColor = WHITE,
+        COLORREF borderColor = BLUE,
+        int borderWidth = 5,
+        int cornerRadius = 20,
+        bool centerVertically = true
+    ) {
+        if (!text || *text == _T('\0')) return;
+        panels.draw(text, x, y, width, height, textColor, bgColor, borderColor, borderWidth, cornerRadius, centerVertically);
+    }
+};
+
+// 主函数
+int main() {
+    // Sleep 默认精度约 15 毫秒，逻辑帧只有 10 毫秒，需要调到 1 毫秒
+    timeBeginPeriod(1);
+    initgraph(windowWidth, windowHeight);
+    setbkcolor(WHITE);
+    cleardevice();
+
+    Game game;
+    game.run();
+
+    closegraph();
+    timeEndPeriod(1);
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include "mcts_ai.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// UCB 的探索系数，评估值在 [0, 1] 内
+const double exploration = 0.7;
+// 评估：得分差加上死亡惩罚，按 valueScale 缩放到 [0, 1]
+const double deathPenalty = 20;
+const double valueScale = 20;
+// 每个工作线程的树节点上限
+const int nodesPerWorker = 1 << 15;
+
+// 模拟中使用的输入源：自己的蛇先按计划的方向序列走，之后和对手一样用随机安全策略
+class RolloutInput : public InputSource {
+private:
+    const Simulation& sim;
+    Rng& rng;
+    int player;
+    const vector<Direction>& plan;
+    // 自己的蛇已决策的步数
+    int moves;
+    // 每名玩家上次决策的帧号，同一帧只决策一次
+    long long decidedTick[3];
+
+public:
+    RolloutInput(const Simulation& sim_, Rng& rng_, int player_, const vector<Direction>& plan_)
+        : sim(sim_), rng(rng_), player(player_), plan(plan_), moves(0) {
+        decidedTick[0] = decidedTick[1] = decidedTick[2] = -1;
+        // 控制玩家2时，真实对局在这一帧已经读过玩家1 的按键，副本里不再替它决策
+        if (player == 2) {
+            decidedTick[1] = sim.getTickCount();
+        }
+    }
+
+    int getMoves() const {
+        return moves;
+    }
+
+    pair<int, keyStatus> getKey(keyStatus keyType) override {
+        int p = (keyType == p1) ? 1 : (keyType == p2) ? 2 : 0;
+        if (p == 0) {
+            return make_pair(-1, none);
+        }
+        const Snake& s = (p == 1) ? sim.getSnake1() : sim.getSnake2();
+        if (!sim.isMovingThisFrame(p) || decidedTick[p] == sim.getTickCount()) {
+            return make_pair(-1, none);
+        }
+        decidedTick[p] = sim.getTickCount();
+
+        Direction d;
+        if (p == player && moves < static_cast<int>(plan.size())) {
+            d = plan[moves];
+        }
+        else {
+            d = AIInput::randomSafeTurn(sim.getMap(), s, rng);
+        }
+        if (p == player) {
+            ++moves;
+        }
+        if (d == stop || d == s.getDirection()) {
+            return make_pair(-1, none);
+        }
+        return keyForDirection(p, d);
+    }
+};
+
+}
+
+MctsAI::MctsAI(const Simulation& sim_, int player_, ThreadPool& pool_, InputSource* others_,
+    int budgetMicros_, int horizon_, uint64_t seed)
+    : AIInput(sim_, player_, others_), pool(pool_), budgetMicros(budgetMicros_), horizon(horizon_),
+    nodeCapacity(nodesPerWorker), rollouts(0), rolloutTicks(0) {
+    const GameMap& map = sim.getMap();
+    workers.reserve(pool.size());
+    for (int i = 0; i < pool.size(); ++i) {
+        workers.emplace_back(map.getWidth(), map.getHeight(), seed + i, nodeCapacity);
+    }
+    fill(rootVisits, rootVisits + 5, 0);
+}
+
+double MctsAI::simulate(Worker& w, Direction current) {
+    // 选择：从根沿 UCB 最大的子节点向下，到达没访问过的节点为止；访问过的叶子先展开
+    w.path.clear();
+    w.plan.clear();
+    int node = 0;
+    Direction incoming = current;
+    w.path.push_back(node);
+    while (static_cast<int>(w.plan.size()) < horizon) {
+        if (w.nodes[node].firstChild < 0) {
+            if ((node != 0 && w.nodes[node].visits == 0) || static_cast<int>(w.nodes.size()) + 4 > nodeCapacity) {
+                break;
+            }
+            w.nodes[node].firstChild = static_cast<int>(w.nodes.size());
+            for (int i = 0; i < 4; ++i) {
+                w.nodes.push_back(Node{ -1, 0, 0 });
+            }
+        }
+
+        const Node& parent = w.nodes[node];
+        double logVisits = log(static_cast<double>(max(parent.visits, 1)));
+        Direction back = oppositeDirection(incoming);
+        int best = -1;
+        double bestScore = -1;
+        // 没访问过的子节点优先，从随机的方向开始找，避免总偏向某个方向
+        int offset = w.rng.below(4);
+        for (int k = 0; k < 4; ++k) {
+            int d = up + (offset + k) % 4;
+            if (d == back) {
+                continue;
+            }
+            const Node& child = w.nodes[parent.firstChild + d - up];
+            double score = (child.visits == 0) ? 2
+                : child.valueSum / child.visits + exploration * sqrt(logVisits / child.visits);
+            if (score > bestScore) {
+                best = d;
+                bestScore = score;
+            }
+        }
+        node = w.nodes[node].firstChild + best - up;
+        incoming = static_cast<Direction>(best);
+        w.path.push_back(node);
+        w.plan.push_back(incoming);
+        if (w.nodes[node].visits == 0) {
+            break;
+        }
+    }
+
+    // 模拟：复制当前局面，补完这一帧后继续推进到自己的蛇走满 horizon 步、死亡或对局结束
+    Simulation& s = w.scratch;
+    s = sim;
+    // 界面上的对局开着变化格子记录，模拟里没人读取，关掉免得每一步都记
+    s.setDirtyTracking(false);
+    const Snake& self = (player == 1) ? s.getSnake1() : s.getSnake2();
+    const Snake& rival = (player == 1) ? s.getSnake2() : s.getSnake1();
+    int selfScore = (player == 1) ? s.getScore1() : s.getScore2();
+    int rivalScore = (player == 1) ? s.getScore2() : s.getScore1();
+    int selfLife = self.getLife(), rivalLife = rival.getLife();
+    long long startTick = s.getTickCount();
+
+    RolloutInput input(s, w.rng, player, w.plan);
+    s.finishTick(input);
+    while (!s.isEnded() && input.getMoves() < horizon && self.getLife() == selfLife) {
+        // 模拟的输入只在蛇移动的那一帧转向，没有蛇移动的空帧直接跳过
+        s.skipIdleTicks(normalMoveInterval);
+        s.update(input);
+    }
+    ++w.rollouts;
+    w.rolloutTicks += s.getTickCount() - startTick + 1;
+
+    // 评估：自己的得分增量减去对手的，再算上双方死亡的次数
+    double gain = ((player == 1) ? s.getScore1() : s.getScore2()) - selfScore;
+    double value = gain - deathPenalty * (selfLife - self.getLife());
+    if (s.isPair()) {
+        value -= ((player == 1) ? s.getScore2() : s.getScore1()) - rivalScore;
+        value += deathPenalty * (rivalLife - rival.getLife());
+    }
+    value = 0.5 + 0.5 * min(max(value / valueScale, -1.0), 1.0);
+
+    // 回传
+    for (int n : w.path) {
+        ++w.nodes[n].visits;
+        w.nodes[n].valueSum += value;
+    }
+    return value;
+}
+
+void MctsAI::search(Worker& w, Direction current, chrono::steady_clock::time_point deadline) {
+    w.nodes.clear();
+    w.nodes.push_back(Node{ -1, 0, 0 });
+    do {
+        simulate(w, current);
+    } while (chrono::steady_clock::now() < deadline);
+}
+
+Direction MctsAI::decide(const Snake& self, const Snake* rival) {
+    (void)rival;
+    auto deadline = chrono::steady_clock::now() + chrono::microseconds(budgetMicros);
+    Direction current = self.getDirection();
+
+    // 根并行：每个工作线程各搜一棵树，主线程等待全部完成
+    pool.parallelFor(static_cast<int>(workers.size()), 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            search(workers[i], current, deadline);
+        }
+    });
+
+    // 合并各线程根节点的子节点：访问次数最多的方向，相同时取平均评估值高的
+    fill(rootVisits, rootVisits + 5, 0);
+    double rootValue[5] = { 0, 0, 0, 0, 0 };
+    for (Worker& w : workers) {
+        rollouts += w.rollouts;
+        rolloutTicks += w.rolloutTicks;
+        w.rollouts = 0;
+        w.rolloutTicks = 0;
+        int first = w.nodes[0].firstChild;
+        if (first < 0) {
+            continue;
+        }
+        for (int d = up; d <= right_dir; ++d) {
+            rootVisits[d] += w.nodes[first + d - up].visits;
+            rootValue[d] += w.nodes[first + d - up].valueSum;
+        }
+    }
+    Direction best = stop;
+    for (int d = up; d <= right_dir; ++d) {
+        if (rootVisits[d] == 0) {
+            continue;
+        }
+        if (best == stop || rootVisits[d] > rootVisits[best]
+            || (rootVisits[d] == rootVisits[best] && rootValue[d] / rootVisits[d] > rootValue[best] / rootVisits[best])) {
+            best = static_cast<Direction>(d);
+        }
+    }
+    return best;
+}
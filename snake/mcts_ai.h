@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "ai_input.h"
+#include "rng.h"
+#include "thread_pool.h"
+
+// 蒙特卡洛树搜索 AI：蛇每次移动前，在时间预算内从当前局面反复复制出副本并模拟到若干步之后，
+// 按得分差与死亡情况评估，选出平均结果最好的方向
+// 副本直接用规则引擎推进，蛇头相撞、尸体变墙/变食物等规则与真实对局完全一致；对手在模拟中用随机安全策略
+// 搜索树只记录自己的方向序列（开环），每次模拟从根重新推演，食物刷新和对手的随机性由多次模拟平均掉
+// 多线程采用根并行：每个工作线程有自己的搜索树、对局副本和随机数发生器，结束时把根节点各方向的访问次数相加
+// 副本、树节点等缓冲区在构造时按地图大小分配好，复制对局只是向已分配好的内存里拷贝，决策过程中不分配内存
+class MctsAI : public AIInput {
+private:
+    // 树节点：四个方向的子节点连续存放在 firstChild 开始的位置，未展开时为 -1
+    struct Node {
+        int firstChild;
+        int visits;
+        double valueSum;
+    };
+
+    // 每个工作线程的搜索状态
+    struct Worker {
+        Simulation scratch;
+        std::vector<Node> nodes;
+        // 本次模拟在树中经过的节点，以及对应的自己的方向序列
+        std::vector<int> path;
+        std::vector<Direction> plan;
+        Rng rng;
+        long long rollouts;
+        long long rolloutTicks;
+
+        Worker(int width, int height, uint64_t seed, int nodeCapacity)
+            : scratch(width, height), rng(seed, 3), rollouts(0), rolloutTicks(0) {
+            nodes.reserve(nodeCapacity);
+            path.reserve(nodeCapacity);
+            plan.reserve(nodeCapacity);
+        }
+    };
+
+    ThreadPool& pool;
+    std::vector<Worker> workers;
+    // 每次决策的时间预算（微秒）
+    int budgetMicros;
+    // 每次模拟自己的蛇最多再走多少步
+    int horizon;
+    int nodeCapacity;
+
+    // 最近一次决策根节点各方向的访问次数（各线程之和）
+    int rootVisits[5];
+
+    long long rollouts;
+    long long rolloutTicks;
+
+    // 一个工作线程在截止时间前反复模拟
+    void search(Worker& w, Direction current, std::chrono::steady_clock::time_point deadline);
+    // 从根开始的一次模拟，返回 [0, 1] 内的评估值
+    double simulate(Worker& w, Direction current);
+
+public:
+    MctsAI(const Simulation& sim_, int player_, ThreadPool& pool_, InputSource* others_ = nullptr,
+        int budgetMicros_ = 5000, int horizon_ = 30, uint64_t seed = 1);
+
+    // 累计模拟次数与模拟中推进的帧数
+    long long getRollouts() const {
+        return rollouts;
+    }
+
+    long long getRolloutTicks() const {
+        return rolloutTicks;
+    }
+
+    int getWorkerCount() const {
+        return static_cast<int>(workers.size());
+    }
+
+    int getRootVisits(Direction d) const {
+        return rootVisits[d];
+    }
+
+    void setBudget(int budgetMicros_) {
+        budgetMicros = budgetMicros_;
+    }
+
+    void resetStats() override {
+        AIInput::resetStats();
+        rollouts = 0;
+        rolloutTicks = 0;
+    }
+
+protected:
+    Direction decide(const Snake& self, const Snake* rival) override;
+};
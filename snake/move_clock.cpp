@@ -0,0 +1,104 @@
+#include "move_clock.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void MoveClock::resize(int count) {
+    nextMove.assign(count, -1);
+    lastMove.assign(count, -1);
+    boostEnd.assign(count, -1);
+    prevInSlot.assign(count, -1);
+    nextInSlot.assign(count, -1);
+    moving.assign(count, 0);
+    fill(wheel, wheel + wheelSize, -1);
+    // 一帧最多所有蛇都移动，预留好后 tick 不再分配内存
+    movers.clear();
+    movers.reserve(count);
+    now = -1;
+}
+
+void MoveClock::unlink(int i) {
+    if (nextMove[i] < 0) {
+        return;
+    }
+    if (prevInSlot[i] >= 0) {
+        nextInSlot[prevInSlot[i]] = nextInSlot[i];
+    }
+    else {
+        wheel[nextMove[i] % wheelSize] = nextInSlot[i];
+    }
+    if (nextInSlot[i] >= 0) {
+        prevInSlot[nextInSlot[i]] = prevInSlot[i];
+    }
+    nextMove[i] = -1;
+}
+
+void MoveClock::schedule(int i) {
+    // 加速间隔到期时仍在加速就按加速间隔移动，否则按平时的间隔
+    long long t = lastMove[i] + speedUpMoveInterval;
+    if (t >= boostEnd[i]) {
+        t = lastMove[i] + normalMoveInterval;
+    }
+    // 中途开始加速时已经等够了加速间隔，下一帧就移动
+    t = max(t, now + 1);
+
+    int slot = static_cast<int>(t % wheelSize);
+    nextMove[i] = t;
+    prevInSlot[i] = -1;
+    nextInSlot[i] = wheel[slot];
+    if (wheel[slot] >= 0) {
+        prevInSlot[wheel[slot]] = i;
+    }
+    wheel[slot] = i;
+}
+
+void MoveClock::restart(int i, bool alive) {
+    unlink(i);
+    lastMove[i] = now;
+    boostEnd[i] = now;
+    moving[i] = 0;
+    if (alive) {
+        schedule(i);
+    }
+}
+
+void MoveClock::setSpeedUp(int i) {
+    // 按帧计时，无论在一秒中的哪个时刻吃到，加速都正好持续 speedUpDuration 毫秒
+    boostEnd[i] = now + speedUpDuration / frameInterval;
+    if (nextMove[i] >= 0) {
+        unlink(i);
+        schedule(i);
+    }
+}
+
+void MoveClock::tick(long long t) {
+    for (int i : movers) {
+        moving[i] = 0;
+    }
+    movers.clear();
+    now = t;
+
+    // 这一格上的蛇都在第 t 帧移动：所有排好的移动都在 now 之后 normalMoveInterval 帧以内，不会绕圈
+    int slot = static_cast<int>(t % wheelSize);
+    for (int i = wheel[slot]; i >= 0; i = nextInSlot[i]) {
+        movers.push_back(i);
+    }
+    wheel[slot] = -1;
+    // 按编号处理，结果与链表中的先后顺序无关
+    sort(movers.begin(), movers.end());
+    for (int i : movers) {
+        moving[i] = 1;
+        lastMove[i] = t;
+        schedule(i);
+    }
+}
+
+long long MoveClock::nextEvent() const {
+    for (long long t = now + 1; t <= now + wheelSize; ++t) {
+        if (wheel[t % wheelSize] >= 0) {
+            return t;
+        }
+    }
+    return -1;
+}
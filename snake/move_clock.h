@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "config.h"
+
+// 加速持续时间（毫秒），以及平时/加速时的移动间隔（帧）
+const int speedUpDuration = 10000;
+const int normalMoveInterval = 9;
+const int speedUpMoveInterval = 5;
+
+// 蛇的移动节奏：每条蛇下一次移动的帧与加速结束的帧都是确定的时间点，按事件调度，
+// 不再每帧给每条蛇计数。下一次移动最多在 normalMoveInterval 帧之后，所以用一个
+// wheelSize 格的时间轮就够了：第 t 帧移动的蛇挂在第 t % wheelSize 格的链表上，
+// tick 只取出当前这一格，nextEvent 给出下一次有蛇移动的帧，无界面的模拟可以直接跳过中间的空帧
+// 每条蛇的数据按结构体数组（SoA）存放，下标为蛇的编号；蛇身、转向队列等仍放在 Snake 里
+class MoveClock {
+private:
+    static const int wheelSize = 16;
+
+    // 下一次移动的帧（不在场上为 -1）、上一次移动（或出生）的帧、加速结束的帧（这一帧起不再加速）
+    std::vector<long long> nextMove;
+    std::vector<long long> lastMove;
+    std::vector<long long> boostEnd;
+    // 时间轮每一格链表中的前后两条蛇，没有为 -1
+    std::vector<int> prevInSlot;
+    std::vector<int> nextInSlot;
+    // 这一帧是否移动，取值 0 或 1
+    std::vector<uint8_t> moving;
+    // 时间轮每一格链表的第一条蛇
+    int wheel[wheelSize];
+    // 这一帧移动的蛇，按编号从小到大
+    std::vector<int> movers;
+    // 当前帧，开局前为 -1
+    long long now;
+
+    // 按上一次移动的帧与加速状态排好下一次移动，挂到时间轮上
+    void schedule(int i);
+    void unlink(int i);
+
+public:
+    explicit MoveClock(int count = 0) {
+        resize(count);
+    }
+
+    // 设置蛇的条数并回到开局前，所有蛇都不在场上
+    void resize(int count);
+
+    int size() const {
+        return static_cast<int>(nextMove.size());
+    }
+
+    // 蛇（重新）出生或死亡后调用：从当前帧重新计数、取消加速，alive 为是否还在场上
+    void restart(int i, bool alive);
+
+    // 吃到加速食物，从当前帧起加速 speedUpDuration 毫秒，已在加速时重新计时
+    void setSpeedUp(int i);
+
+    // 推进到第 t 帧（从 0 开始，必须晚于上一次调用且中间没有跳过任何移动），取出这一帧移动的蛇
+    void tick(long long t);
+
+    // 下一次有蛇移动的帧，没有蛇在场上时为 -1
+    long long nextEvent() const;
+
+    // 这一帧是否移动（tick 之后有效）
+    bool isMoving(int i) const {
+        return moving[i] != 0;
+    }
+
+    bool isSpeedUp(int i) const {
+        return now < boostEnd[i];
+    }
+
+    const std::vector<int>& getMovers() const {
+        return movers;
+    }
+};
@@ -0,0 +1,70 @@
+#include "pixelimage.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void compositeOver(PixelImage& img, uint32_t background) {
+    uint32_t br = (background >> 16) & 0xFF, bg = (background >> 8) & 0xFF, bb = background & 0xFF;
+    for (uint32_t& p : img.pixels) {
+        uint32_t a = p >> 24;
+        uint32_t r = (p >> 16) & 0xFF, g = (p >> 8) & 0xFF, b = p & 0xFF;
+        // 四舍五入的 x * a / 255
+        r = (r * a + br * (255 - a) + 127) / 255;
+        g = (g * a + bg * (255 - a) + 127) / 255;
+        b = (b * a + bb * (255 - a) + 127) / 255;
+        p = (r << 16) | (g << 8) | b;
+    }
+}
+
+PixelImage scaleImage(const PixelImage& src, int width, int height) {
+    if (src.width == width && src.height == height) {
+        return src;
+    }
+    PixelImage dst(width, height);
+    if (src.empty() || width <= 0 || height <= 0) {
+        return dst;
+    }
+
+    // 以像素中心对齐采样，坐标用 16.16 定点数
+    const int64_t stepX = (static_cast<int64_t>(src.width) << 16) / width;
+    const int64_t stepY = (static_cast<int64_t>(src.height) << 16) / height;
+    for (int y = 0; y < height; ++y) {
+        int64_t fy = max<int64_t>(0, (y * stepY) + stepY / 2 - 0x8000);
+        int y0 = min(static_cast<int>(fy >> 16), src.height - 1);
+        int y1 = min(y0 + 1, src.height - 1);
+        uint32_t wy = static_cast<uint32_t>(fy & 0xFFFF) >> 8;
+        const uint32_t* row0 = &src.pixels[static_cast<size_t>(y0) * src.width];
+        const uint32_t* row1 = &src.pixels[static_cast<size_t>(y1) * src.width];
+        uint32_t* out = &dst.pixels[static_cast<size_t>(y) * width];
+
+        for (int x = 0; x < width; ++x) {
+            int64_t fx = max<int64_t>(0, (x * stepX) + stepX / 2 - 0x8000);
+            int x0 = min(static_cast<int>(fx >> 16), src.width - 1);
+            int x1 = min(x0 + 1, src.width - 1);
+            uint32_t wx = static_cast<uint32_t>(fx & 0xFFFF) >> 8;
+
+            // 四个通道分别插值，权重为 8 位
+            uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                uint32_t a = (row0[x0] >> shift) & 0xFF, b = (row0[x1] >> shift) & 0xFF;
+                uint32_t c = (row1[x0] >> shift) & 0xFF, d = (row1[x1] >> shift) & 0xFF;
+                uint32_t top = a * (256 - wx) + b * wx;
+                uint32_t bottom = c * (256 - wx) + d * wx;
+                uint32_t v = (top * (256 - wy) + bottom * wy + (1 << 15)) >> 16;
+                result |= min(v, 255u) << shift;
+            }
+            out[x] = result;
+        }
+    }
+    return dst;
+}
+
+void blitImage(PixelImage& dst, const PixelImage& src, int x, int y) {
+    int x0 = max(x, 0), y0 = max(y, 0);
+    int x1 = min(x + src.width, dst.width), y1 = min(y + src.height, dst.height);
+    for (int row = y0; row < y1; ++row) {
+        const uint32_t* from = &src.pixels[static_cast<size_t>(row - y) * src.width + (x0 - x)];
+        copy(from, from + (x1 - x0), &dst.pixels[static_cast<size_t>(row) * dst.width + x0]);
+    }
+}
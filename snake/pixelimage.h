@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 一张像素图，每个像素 0xAARRGGBB，合成到背景之后 AA 为 0
+struct PixelImage {
+    int width, height;
+    std::vector<uint32_t> pixels;
+
+    PixelImage() : width(0), height(0) {
+    }
+
+    PixelImage(int width_, int height_, uint32_t color = 0)
+        : width(width_), height(height_), pixels(static_cast<size_t>(width_) * height_, color) {
+    }
+
+    bool empty() const {
+        return pixels.empty();
+    }
+};
+
+// 按透明度把图片合成到纯色背景上，结果不再带透明度
+void compositeOver(PixelImage& img, uint32_t background);
+
+// 双线性缩放到指定尺寸，尺寸相同时直接复制
+PixelImage scaleImage(const PixelImage& src, int width, int height);
+
+// 把 src 复制到 dst 的 (x, y) 处，超出部分裁掉
+void blitImage(PixelImage& dst, const PixelImage& src, int x, int y);
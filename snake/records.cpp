@@ -0,0 +1,307 @@
+#include "records.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char storeMagic[4] = { 'S', 'N', 'K', 'L' };
+// 第 2 版起用时以毫秒记录，第 1 版以秒记录
+const uint32_t storeFormat = 2;
+const uint32_t secondsFormat = 1;
+
+#ifndef _WIN32
+// 改名只修改了所在目录，目录也要刷盘，否则断电后可能还是旧文件
+void syncParentDir(const string& path) {
+    size_t slash = path.find_last_of('/');
+    string dir = (slash == string::npos) ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int d = ::open(dir.c_str(), O_RDONLY);
+    if (d >= 0) {
+        fsync(d);
+        ::close(d);
+    }
+}
+#endif
+
+}
+
+// --- MappedFile ---
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : view(nullptr), length(0), fileHandle(nullptr), mappingHandle(nullptr) {
+}
+
+bool MappedFile::open(const string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    length = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    // Windows 下必须先解除映射、关闭句柄，才能用改名替换该文件
+    if (view) {
+        UnmapViewOfFile(view);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+    }
+    view = nullptr;
+    length = 0;
+    fileHandle = mappingHandle = nullptr;
+}
+
+#else
+
+MappedFile::MappedFile() : view(nullptr), length(0), fd(-1) {
+}
+
+bool MappedFile::open(const string& path) {
+    close();
+    int f = ::open(path.c_str(), O_RDONLY);
+    if (f < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(f, &st) != 0 || st.st_size == 0) {
+        ::close(f);
+        return false;
+    }
+    void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, f, 0);
+    if (p == MAP_FAILED) {
+        ::close(f);
+        return false;
+    }
+    fd = f;
+    view = p;
+    length = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close() {
+    if (view) {
+        munmap(const_cast<void*>(view), length);
+        ::close(fd);
+    }
+    view = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+// --- LeaderboardStore ---
+
+LeaderboardStore::LeaderboardStore(const string& path_)
+    : path(path_), image(&emptyImage), emptyImage(makeEmptyImage()), unsaved(emptyImage) {
+    load();
+}
+
+LeaderboardStore::FileImage LeaderboardStore::makeEmptyImage() {
+    FileImage img;
+    memset(&img, 0, sizeof(img));
+    memcpy(img.magic, storeMagic, 4);
+    img.format = storeFormat;
+    img.capacity = topK;
+    img.checksum = computeChecksum(img);
+    return img;
+}
+
+uint32_t LeaderboardStore::computeChecksum(const FileImage& img) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(&img.counts);
+    const unsigned char* end = reinterpret_cast<const unsigned char*>(&img) + sizeof(img);
+    uint32_t h = 2166136261u;
+    for (; p < end; ++p) {
+        h = (h ^ *p) * 16777619u;
+    }
+    return h;
+}
+
+bool LeaderboardStore::load() {
+    image = &emptyImage;
+    if (!mapped.open(path)) {
+        return false;
+    }
+    // 只校验定长头部与校验和，不做任何解析
+    const FileImage* img = static_cast<const FileImage*>(mapped.data());
+    if (mapped.size() != sizeof(FileImage) || memcmp(img->magic, storeMagic, 4) != 0
+        || (img->format != storeFormat && img->format != secondsFormat) || img->capacity != topK
+        || img->checksum != computeChecksum(*img)) {
+        mapped.close();
+        return false;
+    }
+    for (int b = 0; b < boardCount; ++b) {
+        if (img->counts[b] > static_cast<uint32_t>(topK)) {
+            mapped.close();
+            return false;
+        }
+    }
+    if (img->format == secondsFormat) {
+        return migrateFromSeconds(*img);
+    }
+    image = img;
+    return true;
+}
+
+bool LeaderboardStore::migrateFromSeconds(const FileImage& old) {
+    // old 指向映射的内容，先复制再解除映射
+    FileImage next = old;
+    mapped.close();
+    next.format = storeFormat;
+    for (int b = 0; b < boardCount; ++b) {
+        for (uint32_t i = 0; i < next.counts[b]; ++i) {
+            next.entries[b][i].timeMs *= 1000;
+        }
+    }
+    next.checksum = computeChecksum(next);
+    if (!writeAtomically(next)) {
+        // 写盘失败时至少在内存中使用升级后的内容
+        unsaved = next;
+        image = &unsaved;
+    }
+    return true;
+}
+
+bool LeaderboardStore::writeAtomically(const FileImage& img) {
+    string tmpPath = path + ".tmp";
+#ifdef _WIN32
+    HANDLE file = CreateFileA(tmpPath.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    DWORD written = 0;
+    bool ok = WriteFile(file, &img, sizeof(img), &written, NULL) && written == sizeof(img)
+        && FlushFileBuffers(file);
+    CloseHandle(file);
+    if (!ok) {
+        DeleteFileA(tmpPath.c_str());
+        return false;
+    }
+    mapped.close();
+    image = &emptyImage;
+    if (!MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        DeleteFileA(tmpPath.c_str());
+        load();
+        return false;
+    }
+#else
+    int f = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (f < 0) {
+        return false;
+    }
+    bool ok = write(f, &img, sizeof(img)) == static_cast<ssize_t>(sizeof(img)) && fsync(f) == 0;
+    ::close(f);
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    syncParentDir(path);
+#endif
+    return load();
+}
+
+int LeaderboardStore::submit(int board, const LeaderboardEntry& e) {
+    int n = count(board);
+    int total = e.score1 + e.score2;
+    // 零分不上榜
+    if (total <= 0) {
+        return -1;
+    }
+    int rank = n;
+    for (int i = 0; i < n; ++i) {
+        const LeaderboardEntry& cur = image->entries[board][i];
+        if (total > cur.score1 + cur.score2) {
+            rank = i;
+            break;
+        }
+    }
+    if (rank >= topK) {
+        return -1;
+    }
+
+    // 在副本上插入，再整体原子替换
+    FileImage next = *image;
+    int newCount = (n < topK) ? n + 1 : topK;
+    for (int i = newCount - 1; i > rank; --i) {
+        next.entries[board][i] = next.entries[board][i - 1];
+    }
+    next.entries[board][rank] = e;
+    next.counts[board] = newCount;
+    next.checksum = computeChecksum(next);
+
+    if (!writeAtomically(next)) {
+        // 写盘失败时至少保留在内存中，空榜保持不变
+        unsaved = next;
+        image = &unsaved;
+    }
+    return rank;
+}
+
+// --- RecordManager ---
+
+void RecordManager::updateSingleInfo(int mode, info newInfo) {
+    LeaderboardEntry e = { newInfo.score1, 0, newInfo.timeMs, 0, static_cast<int64_t>(time(0)) };
+    store.submit(mode, e);
+}
+
+void RecordManager::updatePairInfo(int mode, info newInfo) {
+    LeaderboardEntry e = { newInfo.score1, newInfo.score2, newInfo.timeMs, 0, static_cast<int64_t>(time(0)) };
+    store.submit(3 + mode, e);
+}
+
+info RecordManager::getSingleBestInfo(int mode) const {
+    if (store.count(mode) == 0) {
+        return info(0, 0);
+    }
+    const LeaderboardEntry& e = store.entry(mode, 0);
+    return info(e.timeMs, e.score1);
+}
+
+info RecordManager::getPairBestInfo(int mode) const {
+    if (store.count(3 + mode) == 0) {
+        return info(0, 0, 0);
+    }
+    const LeaderboardEntry& e = store.entry(3 + mode, 0);
+    return info(e.timeMs, e.score1, e.score2);
+}
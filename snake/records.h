@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// 排行榜中的一条成绩，定长记录直接映射到文件
+struct LeaderboardEntry {
+    int32_t score1;
+    int32_t score2;
+    // 用时（毫秒）
+    int32_t timeMs;
+    int32_t reserved;
+    // 取得成绩的时间（time_t）
+    int64_t date;
+};
+
+// 只读内存映射文件，Windows 与 POSIX 各自实现
+class MappedFile {
+private:
+    const void* view;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // 映射整个文件，文件不存在或为空时返回 false
+    bool open(const std::string& path);
+    void close();
+
+    const void* data() const {
+        return view;
+    }
+
+    size_t size() const {
+        return length;
+    }
+};
+
+// 持久化排行榜：单人/双人 × 三个版本共 6 张榜，每张保留前 topK 名
+// 文件是定长结构，启动时直接映射而不解析；更新时先写临时文件再改名替换，进程中途被杀也不会留下半个文件
+class LeaderboardStore {
+public:
+    static const int topK = 10;
+    static const int boardCount = 6;
+
+    // 文件布局，整个结构原样写入磁盘
+    struct FileImage {
+        char magic[4];
+        uint32_t format;
+        uint32_t capacity;
+        // 对 counts 与 entries 的 FNV-1a 校验，用于识别损坏的文件
+        uint32_t checksum;
+        uint32_t counts[boardCount];
+        LeaderboardEntry entries[boardCount][topK];
+    };
+
+private:
+    std::string path;
+    MappedFile mapped;
+    // 指向映射的文件内容，文件不存在或损坏时指向空榜，写盘失败时指向内存中的最新内容
+    const FileImage* image;
+    const FileImage emptyImage;
+    FileImage unsaved;
+
+    static uint32_t computeChecksum(const FileImage& img);
+    static FileImage makeEmptyImage();
+
+    // 把旧版（用时以秒计）的文件换算成毫秒，按当前版本写回
+    bool migrateFromSeconds(const FileImage& old);
+
+    // 把新内容写到临时文件、刷盘后改名替换旧文件，并刷新目录使改名落盘
+    bool writeAtomically(const FileImage& img);
+
+public:
+    explicit LeaderboardStore(const std::string& path_);
+
+    LeaderboardStore(const LeaderboardStore&) = delete;
+    LeaderboardStore& operator=(const LeaderboardStore&) = delete;
+
+    // 重新映射磁盘上的文件，返回文件是否存在且有效；旧版文件会先升级
+    bool load();
+
+    int count(int board) const {
+        return static_cast<int>(image->counts[board]);
+    }
+
+    // 第 rank 名（从 0 开始）
+    const LeaderboardEntry& entry(int board, int rank) const {
+        return image->entries[board][rank];
+    }
+
+    // 提交一条成绩，按 score1 + score2 从高到低排名，同分时先取得的在前
+    // 进入前 topK 名时立即写盘并返回名次，否则（包括零分）返回 -1
+    int submit(int board, const LeaderboardEntry& e);
+};
+
+// 记录信息结构体
+struct info {
+    // 用时（毫秒）
+    int timeMs;
+    int score1, score2;
+
+    // 同时适用于单人和双人模式的构造函数
+    info(int timeMs_ = 0, int score_1 = 0, int score2_ = -1) : timeMs(timeMs_), score1(score_1), score2(score2_) {
+    }
+};
+
+// 记录管理类，按模式保存排行榜，数据存放在 LeaderboardStore 中
+class RecordManager {
+private:
+    LeaderboardStore store;
+
+public:
+    explicit RecordManager(const std::string& path = "records.dat") : store(path) {
+    }
+
+    // 更新单人模式记录
+    void updateSingleInfo(int mode, info newInfo);
+
+    // 更新双人模式记录
+    void updatePairInfo(int mode, info newInfo);
+
+    // 获取单人模式记录
+    info getSingleBestInfo(int mode) const;
+
+    // 获取双人模式记录
+    info getPairBestInfo(int mode) const;
+
+    const LeaderboardStore& getStore() const {
+        return store;
+    }
+};
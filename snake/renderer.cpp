@@ -0,0 +1,178 @@
+#include "renderer.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void RenderTarget::fillRects(const DrawRect* rects, size_t count, uint32_t color) {
+    for (size_t i = 0; i < count; ++i) {
+        fillRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h, color);
+    }
+}
+
+void RenderTarget::drawSprites(const DrawPoint* points, size_t count, int sprite) {
+    for (size_t i = 0; i < count; ++i) {
+        drawSprite(points[i].x, points[i].y, sprite);
+    }
+}
+
+void DrawBatch::addRect(int x, int y, int w, int h, uint32_t color) {
+    ++rectCount;
+    for (auto& group : rectGroups) {
+        if (group.first == color) {
+            group.second.push_back(DrawRect{ x, y, w, h });
+            return;
+        }
+    }
+    rectGroups.push_back(make_pair(color, vector<DrawRect>(1, DrawRect{ x, y, w, h })));
+}
+
+void DrawBatch::addSprite(int x, int y, int sprite) {
+    ++spriteCount_;
+    spriteGroups[sprite].push_back(DrawPoint{ x, y });
+}
+
+void DrawBatch::addCircle(int cx, int cy, int r, uint32_t color) {
+    circles.push_back(Circle{ cx, cy, r, color });
+}
+
+int DrawBatch::submit(RenderTarget& target) {
+    int calls = 0;
+    for (auto& group : rectGroups) {
+        if (!group.second.empty()) {
+            target.fillRects(group.second.data(), group.second.size(), group.first);
+            group.second.clear();
+            ++calls;
+        }
+    }
+    for (int s = 0; s < static_cast<int>(spriteGroups.size()); ++s) {
+        if (!spriteGroups[s].empty()) {
+            target.drawSprites(spriteGroups[s].data(), spriteGroups[s].size(), s);
+            spriteGroups[s].clear();
+            ++calls;
+        }
+    }
+    for (const Circle& c : circles) {
+        target.fillCircle(c.cx, c.cy, c.r, c.color);
+        ++calls;
+    }
+    circles.clear();
+    rectCount = spriteCount_ = 0;
+    return calls;
+}
+
+BoardRenderer::BoardRenderer(int cellSize_) : cellSize(cellSize_), fullRedraw(true), lastCells(0), lastRects(0), lastCalls(0) {
+    lastHead[0] = lastHead[1] = -1;
+}
+
+int BoardRenderer::headCell(const Simulation& sim, const Snake& snake) const {
+    if (snake.getLife() <= 0 || snake.getBody().empty()) {
+        return -1;
+    }
+    auto head = snake.getHeadPos();
+    return sim.getMap().index(head.first, head.second);
+}
+
+BoardRenderer::CellPaint BoardRenderer::paintOf(const Simulation& sim, const RenderTarget& target,
+    int cell, const int heads[2]) const {
+    const GameMap& map = sim.getMap();
+    switch (map.getCell(cell)) {
+    case wall:
+        return CellPaint{ paintRect, colorWall };
+    case snake1Body:
+    case snake2Body: {
+        int player = (map.getCell(cell) == snake1Body) ? 0 : 1;
+        if (cell == heads[player] && target.hasSprite(spriteHead1 + player)) {
+            return CellPaint{ paintSprite, static_cast<uint32_t>(spriteHead1 + player) };
+        }
+        return CellPaint{ paintRect, player == 0 ? colorSnake1 : colorSnake2 };
+    }
+    case food: {
+        int id = sim.getFoodManager().getScore(map.position(cell)) - 1;
+        if (id >= 0 && target.hasSprite(spriteFood + id)) {
+            return CellPaint{ paintSprite, static_cast<uint32_t>(spriteFood + id) };
+        }
+        // 没有贴图：白底绿圆
+        return CellPaint{ paintFallbackFood, 0 };
+    }
+    default:
+        return CellPaint{ paintRect, colorBackground };
+    }
+}
+
+void BoardRenderer::batchCells(const Simulation& sim, const RenderTarget& target, const int heads[2]) {
+    const GameMap& map = sim.getMap();
+    int width = map.getWidth();
+    size_t i = 0;
+    while (i < cells.size()) {
+        int cell = cells[i];
+        CellPaint paint = paintOf(sim, target, cell, heads);
+        int px = (cell % width) * cellSize;
+        int py = (cell / width) * cellSize;
+        ++i;
+
+        if (paint.kind == paintSprite) {
+            batch.addSprite(px, py, static_cast<int>(paint.value));
+            continue;
+        }
+        if (paint.kind == paintFallbackFood) {
+            batch.addRect(px, py, cellSize, cellSize, colorBackground);
+            batch.addCircle(px + cellSize / 2, py + cellSize / 2, cellSize / 2, colorFood);
+            continue;
+        }
+
+        // 向右合并同一行里紧挨着、颜色相同的格子
+        int run = 1;
+        while (i < cells.size() && cells[i] == cell + run && (cell + run) % width != 0) {
+            CellPaint next = paintOf(sim, target, cells[i], heads);
+            if (next.kind != paintRect || next.value != paint.value) {
+                break;
+            }
+            ++run;
+            ++i;
+        }
+        batch.addRect(px, py, run * cellSize, cellSize, paint.value);
+    }
+}
+
+int BoardRenderer::draw(Simulation& sim, RenderTarget& target) {
+    const GameMap& map = sim.getMap();
+    int heads[2] = { headCell(sim, sim.getSnake1()), -1 };
+    if (sim.isPair()) {
+        heads[1] = headCell(sim, sim.getSnake2());
+    }
+
+    cells.clear();
+    if (fullRedraw || map.isAllDirty()) {
+        for (int cell = 0; cell < map.getCellCount(); ++cell) {
+            cells.push_back(cell);
+        }
+        fullRedraw = false;
+    }
+    else {
+        cells.insert(cells.end(), map.getDirtyCells().begin(), map.getDirtyCells().end());
+        // 蛇头移动后，旧蛇头要改画成蛇身，新蛇头要画成贴图
+        for (int i = 0; i < 2; ++i) {
+            if (heads[i] != lastHead[i]) {
+                if (lastHead[i] != -1) {
+                    cells.push_back(lastHead[i]);
+                }
+                if (heads[i] != -1) {
+                    cells.push_back(heads[i]);
+                }
+            }
+        }
+        sort(cells.begin(), cells.end());
+        cells.erase(unique(cells.begin(), cells.end()), cells.end());
+    }
+
+    batchCells(sim, target, heads);
+    lastRects = batch.getRectCount();
+    lastCalls = batch.submit(target);
+
+    lastHead[0] = heads[0];
+    lastHead[1] = heads[1];
+    lastCells = static_cast<int>(cells.size());
+    sim.clearDirty();
+    return lastCells;
+}
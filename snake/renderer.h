@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "simulation.h"
+
+// 颜色统一用 0xRRGGBB，由各绘制后端自行转换
+const uint32_t colorBackground = 0xFFFFFF;
+const uint32_t colorWall = 0x000000;
+const uint32_t colorSnake1 = 0xAA0000;
+const uint32_t colorSnake2 = 0x0000AA;
+const uint32_t colorFood = 0x00AA00;
+
+// 贴图编号：两个蛇头，之后依次是 5 种食物
+enum SpriteId {
+    spriteHead1,
+    spriteHead2,
+    spriteFood,
+    spriteCount = spriteFood + 5
+};
+
+struct DrawRect {
+    int x, y, w, h;
+};
+
+struct DrawPoint {
+    int x, y;
+};
+
+// 绘制目标，坐标为像素，矩形不含右边和下边
+// EasyX 界面和软件帧缓冲各实现一份，规则引擎和渲染逻辑不依赖具体图形库
+class RenderTarget {
+public:
+    virtual ~RenderTarget() = default;
+
+    virtual void fillRect(int x, int y, int w, int h, uint32_t color) = 0;
+    virtual void fillCircle(int cx, int cy, int r, uint32_t color) = 0;
+    // 贴图缺失（加载失败）时返回 false，由调用者画替代图形
+    virtual bool drawSprite(int x, int y, int sprite) = 0;
+    virtual bool hasSprite(int sprite) const = 0;
+
+    // 批量绘制同一颜色的矩形 / 同一贴图，默认逐个绘制，后端可以只切换一次状态
+    virtual void fillRects(const DrawRect* rects, size_t count, uint32_t color);
+    virtual void drawSprites(const DrawPoint* points, size_t count, int sprite);
+};
+
+// 绘制批次：先收集本帧的矩形、贴图和圆，提交时按颜色/贴图分组，每组一次调用
+// 提交顺序为矩形、贴图、圆（食物的替代图形是白底上的圆，圆必须在矩形之后）
+class DrawBatch {
+private:
+    // 每种颜色一组矩形，颜色只有几种，线性查找即可；清空时保留容量
+    std::vector<std::pair<uint32_t, std::vector<DrawRect>>> rectGroups;
+    std::vector<std::vector<DrawPoint>> spriteGroups;
+    struct Circle {
+        int cx, cy, r;
+        uint32_t color;
+    };
+    std::vector<Circle> circles;
+    int rectCount, spriteCount_;
+
+public:
+    DrawBatch() : spriteGroups(spriteCount), rectCount(0), spriteCount_(0) {
+    }
+
+    void addRect(int x, int y, int w, int h, uint32_t color);
+    void addSprite(int x, int y, int sprite);
+    void addCircle(int cx, int cy, int r, uint32_t color);
+
+    // 提交到绘制目标并清空，返回绘制调用次数（每组一次，圆逐个计）
+    int submit(RenderTarget& target);
+
+    int getRectCount() const {
+        return rectCount;
+    }
+
+    int getSpriteCount() const {
+        return spriteCount_;
+    }
+};
+
+// 棋盘增量渲染器：只重绘上次渲染以来改变过的格子
+// 改变的格子来自地图的变化记录（新蛇头、空出的蛇尾、吃掉/生成的食物、尸体变食物或墙），
+// 蛇头贴图另外按上次绘制的位置比较，因为蛇头前进时旧蛇头格子的地图元素不变
+// 要画的格子按编号排序后，同一行相邻且颜色相同的格子合并成一个矩形，再整批提交
+class BoardRenderer {
+private:
+    // 一个格子的画法
+    enum PaintKind {
+        paintRect,
+        paintSprite,
+        paintFallbackFood
+    };
+    struct CellPaint {
+        PaintKind kind;
+        // 矩形颜色或贴图编号
+        uint32_t value;
+    };
+
+    int cellSize;
+    // 下一次需要整张重绘（开局、暂停界面覆盖之后）
+    bool fullRedraw;
+    // 上次绘制的蛇头格子，没有为 -1
+    int lastHead[2];
+    // 上次渲染重绘的格子数、合并后的矩形数、提交的绘制调用数
+    int lastCells;
+    int lastRects;
+    int lastCalls;
+
+    // 本帧要画的格子，复用容量
+    std::vector<int> cells;
+    DrawBatch batch;
+
+    // 当前蛇头所在格子，蛇已死亡为 -1
+    int headCell(const Simulation& sim, const Snake& snake) const;
+    CellPaint paintOf(const Simulation& sim, const RenderTarget& target, int cell, const int heads[2]) const;
+    // 把排好序的格子合并成横向连续的矩形加入批次
+    void batchCells(const Simulation& sim, const RenderTarget& target, const int heads[2]);
+
+public:
+    BoardRenderer(int cellSize_ = gridSize);
+
+    // 下一次渲染整张重绘
+    void invalidate() {
+        fullRedraw = true;
+    }
+
+    // 绘制棋盘并清除地图的变化记录，返回重绘的格子数
+    // 规则引擎需要先 setDirtyTracking(true)
+    int draw(Simulation& sim, RenderTarget& target);
+
+    int getLastCells() const {
+        return lastCells;
+    }
+
+    int getLastRects() const {
+        return lastRects;
+    }
+
+    int getLastCalls() const {
+        return lastCalls;
+    }
+};
@@ -0,0 +1,270 @@
+#include "replay.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+
+const uint8_t replayMagic[4] = { 'S', 'N', 'K', 'R' };
+// 第 2 版起加速按帧计时（正好 10 秒），第 1 版的录像在新规则下无法复现
+const uint8_t replayFormat = 2;
+
+// 规则引擎支持的地图尺寸：边长至少 3（四周是墙，中间要有空格），坐标压缩成 16 位，
+// 格子数再设个上限，损坏的文件不会让回放器申请巨大的内存
+const int minMapSide = 3;
+const int maxMapSide = 0xFFFF;
+const long long maxMapCells = 1LL << 24;
+
+void putVarint(vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+bool getVarint(const vector<uint8_t>& in, size_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= in.size()) {
+            return false;
+        }
+        uint8_t b = in[pos++];
+        v |= static_cast<uint64_t>(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+vector<uint8_t> Replay::encode() const {
+    vector<uint8_t> out(replayMagic, replayMagic + 4);
+    out.push_back(replayFormat);
+    out.push_back(static_cast<uint8_t>(mode));
+    out.push_back(static_cast<uint8_t>(version));
+    putVarint(out, width);
+    putVarint(out, height);
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<uint8_t>(seed >> (8 * i)));
+    }
+
+    long long last = 0;
+    for (const auto& e : events) {
+        putVarint(out, e.tick - last);
+        out.push_back(static_cast<uint8_t>((e.player << 4) | e.dir));
+        last = e.tick;
+    }
+    putVarint(out, totalTicks - last);
+    out.push_back(0);
+    putVarint(out, score1);
+    putVarint(out, score2);
+    return out;
+}
+
+bool Replay::decode(const vector<uint8_t>& in) {
+    if (in.size() < 7 || !equal(replayMagic, replayMagic + 4, in.begin()) || in[4] != replayFormat) {
+        return false;
+    }
+    // 头部的模式、版本和地图尺寸直接交给规则引擎，先检查是否合法
+    if ((in[5] != singleMode && in[5] != pairMode) || in[6] < beginner || in[6] > expert) {
+        return false;
+    }
+    mode = static_cast<GameState>(in[5]);
+    version = static_cast<GameVersion>(in[6]);
+    size_t pos = 7;
+    uint64_t v, w;
+    if (!getVarint(in, pos, w) || !getVarint(in, pos, v)) return false;
+    if (w < minMapSide || w > maxMapSide || v < minMapSide || v > maxMapSide
+        || static_cast<long long>(w * v) > maxMapCells) {
+        return false;
+    }
+    width = static_cast<int>(w);
+    height = static_cast<int>(v);
+    if (pos + 8 > in.size()) return false;
+    seed = 0;
+    for (int i = 0; i < 8; ++i) {
+        seed |= static_cast<uint64_t>(in[pos++]) << (8 * i);
+    }
+
+    events.clear();
+    long long tick = 0;
+    while (true) {
+        if (!getVarint(in, pos, v) || pos >= in.size()) return false;
+        tick += static_cast<long long>(v);
+        uint8_t code = in[pos++];
+        if (code == 0) {
+            break;
+        }
+        ReplayEvent e;
+        e.tick = tick;
+        e.player = code >> 4;
+        e.dir = static_cast<Direction>(code & 0xF);
+        // 只接受本局存在的玩家和四个方向
+        if (e.player < 1 || e.player > (mode == pairMode ? 2 : 1) || e.dir < up || e.dir > right_dir) {
+            return false;
+        }
+        events.push_back(e);
+    }
+    totalTicks = tick;
+    if (!getVarint(in, pos, v)) return false;
+    score1 = static_cast<int>(v);
+    if (!getVarint(in, pos, v)) return false;
+    score2 = static_cast<int>(v);
+    return true;
+}
+
+bool Replay::save(const string& path) const {
+    vector<uint8_t> data = encode();
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool Replay::load(const string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return decode(data);
+}
+
+void ReplayRecorder::begin(const Simulation& sim) {
+    replay = Replay();
+    replay.mode = sim.getMode();
+    replay.version = sim.getVersion();
+    replay.width = sim.getMap().getWidth();
+    replay.height = sim.getMap().getHeight();
+    replay.seed = sim.getSeed();
+    active = true;
+}
+
+void ReplayRecorder::record(const Simulation& sim) {
+    if (!active) {
+        return;
+    }
+    // 转向发生在刚推进的这一帧
+    long long tick = sim.getTickCount() - 1;
+    for (int i = 0; i < sim.getTurnCount(); ++i) {
+        const TurnEvent& t = sim.getTurn(i);
+        ReplayEvent e;
+        e.tick = tick;
+        e.player = t.player;
+        e.dir = t.dir;
+        replay.events.push_back(e);
+    }
+}
+
+void ReplayRecorder::finish(const Simulation& sim) {
+    if (!active) {
+        return;
+    }
+    replay.totalTicks = sim.getTickCount();
+    replay.score1 = sim.getScore1();
+    replay.score2 = sim.getScore2();
+    active = false;
+}
+
+void ReplayInput::setTick(long long tick_) {
+    tick = tick_;
+    taken[0] = taken[1] = taken[2] = false;
+    // 二分定位到第一个不早于 tick 的事件，向后跳转时同样适用
+    if (cursor >= replay->events.size() || replay->events[cursor].tick != tick) {
+        auto it = lower_bound(replay->events.begin(), replay->events.end(), tick,
+            [](const ReplayEvent& e, long long t) { return e.tick < t; });
+        cursor = it - replay->events.begin();
+    }
+}
+
+pair<int, keyStatus> ReplayInput::getKey(keyStatus keyType) {
+    int player = (keyType == p1) ? 1 : (keyType == p2) ? 2 : 0;
+    if (taken[player]) {
+        return make_pair(-1, none);
+    }
+    // 同一帧最多两个事件（每位玩家一个）
+    for (size_t i = cursor; i < replay->events.size() && replay->events[i].tick == tick; ++i) {
+        if (replay->events[i].player == player) {
+            taken[player] = true;
+            return keyForDirection(player, replay->events[i].dir);
+        }
+    }
+    return make_pair(-1, none);
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay_, int snapshotInterval_)
+    : replay(replay_), sim(replay_.width, replay_.height), snapshotInterval(snapshotInterval_) {
+    sim.init(replay.mode, replay.version, replay.seed);
+    input.attach(&replay);
+    snapshots.push_back(make_pair(0LL, sim));
+}
+
+void ReplayPlayer::saveSnapshot() {
+    long long tick = sim.getTickCount();
+    // 只在第一次播放到这里时保存快照
+    if (tick % snapshotInterval == 0 && snapshots.back().first < tick) {
+        snapshots.push_back(make_pair(tick, sim));
+    }
+}
+
+bool ReplayPlayer::step() {
+    long long tick = sim.getTickCount();
+    if (tick >= replay.totalTicks || sim.isEnded()) {
+        return false;
+    }
+    input.setTick(tick);
+    sim.update(input);
+    saveSnapshot();
+    return true;
+}
+
+void ReplayPlayer::advanceTo(long long tick) {
+    tick = min(tick, replay.totalTicks);
+    while (sim.getTickCount() < tick && !sim.isEnded()) {
+        // 录像里的转向都发生在蛇移动的那一帧，空帧直接跳过，但不跳过要保存快照的帧
+        long long now = sim.getTickCount();
+        long long nextSnapshot = (now / snapshotInterval + 1) * snapshotInterval;
+        if (sim.skipIdleTicks(min(tick, nextSnapshot) - now) > 0) {
+            saveSnapshot();
+        }
+        else {
+            step();
+        }
+    }
+}
+
+void ReplayPlayer::runToEnd() {
+    advanceTo(replay.totalTicks);
+}
+
+void ReplayPlayer::seek(long long tick) {
+    tick = min(max(tick, 0LL), replay.totalTicks);
+    if (tick < sim.getTickCount() || tick - sim.getTickCount() > snapshotInterval) {
+        // 找到不晚于目标帧的最近快照
+        auto it = upper_bound(snapshots.begin(), snapshots.end(), tick,
+            [](long long t, const pair<long long, Simulation>& s) { return t < s.first; });
+        --it;
+        if (it->first > sim.getTickCount() || tick < sim.getTickCount()) {
+            sim = it->second;
+        }
+    }
+    advanceTo(tick);
+}
+
+bool ReplayPlayer::matchesRecord() const {
+    return sim.getTickCount() == replay.totalTicks
+        && sim.getScore1() == replay.score1 && sim.getScore2() == replay.score2;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "simulation.h"
+
+// 录像中的一次转向
+struct ReplayEvent {
+    long long tick;
+    int player;
+    Direction dir;
+};
+
+// 一局录像：开局参数（模式、版本、地图尺寸、种子）加上逐帧的转向
+// 规则引擎是确定性的，只要这些信息就能完整复现一局
+//
+// 文件格式（小端）：
+//   "SNKR" 版本(1字节) 模式(1字节) 版本号(1字节) 宽(varint) 高(varint) 种子(8字节)
+//   若干事件：距上一事件的帧数(varint) 事件码(1字节，高 4 位玩家，低 4 位方向)
+//   结束记录：距上一事件的帧数(varint) 0 蛇1得分(varint) 蛇2得分(varint)
+struct Replay {
+    GameState mode;
+    GameVersion version;
+    int width, height;
+    uint64_t seed;
+    std::vector<ReplayEvent> events;
+    long long totalTicks;
+    int score1, score2;
+
+    Replay() : mode(singleMode), version(beginner), width(mapWidth), height(mapHeight),
+        seed(1), totalTicks(0), score1(0), score2(0) {
+    }
+
+    std::vector<uint8_t> encode() const;
+    // 解析失败（格式不对、数据截断，或模式、版本、地图尺寸、事件超出规则引擎支持的范围）返回 false
+    bool decode(const std::vector<uint8_t>& data);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// 录像器：开局时记下参数，之后每帧调用 record 记下生效的转向
+class ReplayRecorder {
+private:
+    Replay replay;
+    bool active;
+
+public:
+    ReplayRecorder() : active(false) {
+    }
+
+    void begin(const Simulation& sim);
+
+    // 在每次 Simulation::update 之后调用
+    void record(const Simulation& sim);
+
+    // 记下结束时的帧数和得分，之后不再记录
+    void finish(const Simulation& sim);
+
+    bool isActive() const {
+        return active;
+    }
+
+    const Replay& getReplay() const {
+        return replay;
+    }
+};
+
+// 回放输入：在录像记录的帧把转向还原成对应玩家的按键
+class ReplayInput : public InputSource {
+private:
+    const Replay* replay;
+    size_t cursor;
+    long long tick;
+    // 本帧玩家 1、2 的事件是否已被取走
+    bool taken[3];
+
+public:
+    ReplayInput() : replay(nullptr), cursor(0), tick(0), taken{ false, false, false } {
+    }
+
+    void attach(const Replay* replay_) {
+        replay = replay_;
+        cursor = 0;
+        tick = 0;
+        taken[0] = taken[1] = taken[2] = false;
+    }
+
+    // 在每次 Simulation::update 之前设置即将推进的帧
+    void setTick(long long tick_);
+
+    std::pair<int, keyStatus> getKey(keyStatus keyType) override;
+};
+
+// 回放器：无界面全速重放录像，并周期性保存快照以便快速跳转到任意帧
+class ReplayPlayer {
+private:
+    Replay replay;
+    Simulation sim;
+    ReplayInput input;
+
+    // 每隔 snapshotInterval 帧保存一份完整的对局状态
+    int snapshotInterval;
+    std::vector<std::pair<long long, Simulation>> snapshots;
+
+    // 推进到快照所在的帧时保存快照
+    void saveSnapshot();
+    // 向前推进到第 tick 帧，跳过没有蛇移动的空帧
+    void advanceTo(long long tick);
+
+public:
+    ReplayPlayer(const Replay& replay_, int snapshotInterval_ = 1000);
+
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+    // 推进一帧，已到录像末尾返回 false
+    bool step();
+
+    // 全速播放到录像末尾（跳过没有蛇移动的空帧）
+    void runToEnd();
+
+    // 跳转到第 tick 帧（已推进 tick 帧的状态），向后跳转时从最近的快照恢复
+    void seek(long long tick);
+
+    // 回放结束后的得分是否与录像记录一致
+    bool matchesRecord() const;
+
+    long long getTick() const {
+        return sim.getTickCount();
+    }
+
+    const Simulation& getSimulation() const {
+        return sim;
+    }
+
+    const Replay& getReplay() const {
+        return replay;
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+// 每局独立的伪随机数发生器（PCG32），同一种子得到完全相同的序列
+// 状态只有 16 字节，可随对局一起复制，多线程下各局互不干扰
+class Rng {
+private:
+    uint64_t state;
+    uint64_t inc;
+
+public:
+    explicit Rng(uint64_t seed = 1, uint64_t stream = 0) {
+        reseed(seed, stream);
+    }
+
+    void reseed(uint64_t seed, uint64_t stream = 0) {
+        state = 0;
+        inc = (stream << 1) | 1u;
+        next();
+        state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+    }
+
+    // 返回 [0, n) 内的随机整数（乘法取高位，不做除法）
+    int below(int n) {
+        return static_cast<int>((static_cast<uint64_t>(next()) * static_cast<uint32_t>(n)) >> 32);
+    }
+
+    // 生成 64 位随机数，常用于派生下一局的种子
+    uint64_t next64() {
+        uint64_t hi = next();
+        return (hi << 32) | next();
+    }
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "rng.h"
+#include "simulation.h"
+
+// 脚本输入：每次被询问时以一定概率随机转向，用于无界面的模拟与基准
+class ScriptedInput : public InputSource {
+private:
+    Rng rng;
+    // 不为空时只在蛇移动的那一帧给出转向，每位玩家每帧最多一次
+    const Simulation* sim;
+    long long askedTick[3];
+
+public:
+    // 与对局使用不同的随机流，避免干扰规则引擎的随机序列
+    // 给出 sim 时只在蛇移动的那一帧询问随机数，空帧不读取按键，可以配合 Simulation::skipIdleTicks 使用
+    explicit ScriptedInput(uint64_t seed = 1, const Simulation* sim_ = nullptr) : rng(seed, 1), sim(sim_), askedTick{ -1, -1, -1 } {
+    }
+
+    std::pair<int, keyStatus> getKey(keyStatus keyType) override {
+        static const int p1Keys[4] = { 'W', 'S', 'A', 'D' };
+        static const int p2Keys[4] = { VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT };
+        if (sim) {
+            int player = (keyType == p1) ? 1 : (keyType == p2) ? 2 : 0;
+            if (player == 0 || !sim->isMovingThisFrame(player) || askedTick[player] == sim->getTickCount()) {
+                return std::make_pair(-1, none);
+            }
+            askedTick[player] = sim->getTickCount();
+            // 大约三分之一的移动会尝试转向，与每帧询问时相当
+            if (rng.below(3) != 0) {
+                return std::make_pair(-1, none);
+            }
+        }
+        // 规则引擎每帧都会询问，蛇约 9 帧移动一次，1/27 的概率相当于大约三分之一的移动会尝试转向
+        else if (rng.below(27) != 0) {
+            return std::make_pair(-1, none);
+        }
+        int k = rng.below(4);
+        if (keyType == p1) {
+            return std::make_pair(p1Keys[k], p1);
+        }
+        if (keyType == p2) {
+            return std::make_pair(p2Keys[k], p2);
+        }
+        return std::make_pair(-1, none);
+    }
+};
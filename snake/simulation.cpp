@@ -0,0 +1,243 @@
+#include "simulation.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void Simulation::init(GameState mode_, GameVersion version_, uint64_t seed_) {
+    mode = mode_;
+    version = version_;
+    seed = seed_;
+    rng.reseed(seed);
+    score1 = score2 = 0;
+    tickCount = 0;
+    ended = false;
+    turnCount = 0;
+
+    gameMap.reset();
+    clock.resize(2);
+
+    wallManager.reset(gameMap);
+
+    // 入门版为1条命
+    if (version == beginner) {
+        snake1.reset(gameMap, rng, 1, stop);
+        if (isPair()) {
+            snake2.reset(gameMap, rng, 1, stop);
+        }
+    }
+    // 进阶版满命直到剩余空间不足
+    else if (version == advanced) {
+        // 生命值肯定不会超过地图总格子数
+        snake1.reset(gameMap, rng, gameMap.getCellCount(), stop);
+        if (isPair()) {
+            snake2.reset(gameMap, rng, gameMap.getCellCount(), stop);
+        }
+    }
+    // 高级版5条命
+    else if (version == expert) {
+        snake1.reset(gameMap, rng, 5, stop);
+        if (isPair()) {
+            snake2.reset(gameMap, rng, 5, stop);
+        }
+    }
+
+    // 单人模式下蛇2 不在场上
+    restartClock(snake1);
+    clock.restart(1, isPair() && snake2.getLife() > 0 && !snake2.getBody().empty());
+
+    foodManager.reset();
+    foodManager.generateFood(gameMap, rng);
+}
+
+void Simulation::restartClock(const Snake& snake) {
+    clock.restart(snake.getPlayerId() - 1, snake.getLife() > 0 && !snake.getBody().empty());
+}
+
+void Simulation::drainKeys(Snake& snake, InputSource& input, keyStatus keyType) {
+    // 每个 getKey 只返回一次按键；设个上限，防止输入源一直有键
+    for (int i = 0; i < 4 * maxTurnQueueDepth; ++i) {
+        auto key = input.getKey(keyType);
+        if (key.second == none) {
+            return;
+        }
+        snake.queueTurn(key, input.keyStamp());
+    }
+}
+
+void Simulation::applyTurn(Snake& snake, InputSource& input) {
+    Direction before = snake.getDirection();
+    long long stamp = snake.applyQueuedTurn();
+    if (snake.getDirection() != before) {
+        turns[turnCount].player = snake.getPlayerId();
+        turns[turnCount].dir = snake.getDirection();
+        ++turnCount;
+        if (stamp != 0) {
+            input.turnApplied(snake.getPlayerId(), stamp);
+        }
+    }
+}
+
+void Simulation::update(InputSource& input) {
+    // 游戏已结束，直接返回
+    if (ended) {
+        return;
+    }
+
+    turnCount = 0;
+
+    ++tickCount;
+
+    // 取出这一帧移动的蛇
+    clock.tick(tickCount - 1);
+
+    finishTick(input);
+}
+
+long long Simulation::skipIdleTicks(long long maxTicks) {
+    if (ended || maxTicks <= 0) {
+        return 0;
+    }
+    long long next = clock.nextEvent();
+    long long skip = (next < 0) ? maxTicks : min(next - tickCount, maxTicks);
+    if (skip <= 0) {
+        return 0;
+    }
+    // 空帧里只有时间在走：停在最后一个空帧结束时的状态，与逐帧推进完全一致
+    tickCount += skip;
+    turnCount = 0;
+    clock.tick(tickCount - 1);
+    return skip;
+}
+
+void Simulation::finishTick(InputSource& input) {
+    // 是否移动
+    bool move1 = clock.isMoving(0);
+    bool move2 = isPair() ? clock.isMoving(1) : false;
+
+    // 每帧都把按键读进转向队列，只有移动时才取出一个生效
+    drainKeys(snake1, input, p1);
+    if (isPair()) {
+        drainKeys(snake2, input, p2);
+    }
+    if (move1) {
+        applyTurn(snake1, input);
+    }
+    if (move2) {
+        applyTurn(snake2, input);
+    }
+
+    auto newhead1 = snake1.findNewHead();
+    auto newhead2 = isPair() ? snake2.findNewHead() : make_pair(-1, -1);
+
+
+    //处理蛇头相撞的特殊情况
+    if (move1 || move2) {
+        if (isPair() && (newhead1 == newhead2 || newhead1 == snake2.getHeadPos()
+            || newhead2 == snake1.getHeadPos())) {
+            // 极特殊情况，两头蛇下一帧到达同一位置，这时候应该还需要移动一次以更新食物状态
+            if (newhead1 == newhead2 && newhead1 != snake1.getHeadPos() && newhead2 != snake2.getHeadPos()) {
+                snake1.move(gameMap);
+                snake2.move(gameMap);
+            }
+            if (version == beginner || version == expert) {
+                // 添加两蛇身体为食物
+                foodManager.addFood(gameMap, rng, snake1.getBody());
+                foodManager.addFood(gameMap, rng, snake2.getBody());
+            }
+
+            if (version == advanced) {
+                // 将蛇变为墙
+                wallManager.addWall(gameMap, snake1.getBody());
+                wallManager.addWall(gameMap, snake2.getBody());
+            }
+
+            if (!snake1.reset(gameMap, rng, snake1.getLife() - 1) || !snake2.reset(gameMap, rng, snake2.getLife() - 1)
+                || !foodManager.generateFood(gameMap, rng)) {
+                ended = true;
+            }
+            restartClock(snake1);
+            restartClock(snake2);
+        }
+        // 普通碰撞检测
+        else {
+            // 检查蛇1碰撞
+            if (move1) {
+                if (snake1.checkCollision(gameMap, newhead1)) {
+                    if (version == advanced) {
+                        wallManager.addWall(gameMap, snake1.getBody());
+                    }
+                    else {
+                        foodManager.addFood(gameMap, rng, snake1.getBody());
+                    }
+
+                    if (!snake1.reset(gameMap, rng, snake1.getLife() - 1) || !foodManager.generateFood(gameMap, rng)) {
+                        ended = true;
+                    }
+                    restartClock(snake1);
+                }
+                else {
+                    snake1.move(gameMap);
+                }
+            }
+
+            // 检查蛇2碰撞
+            if (isPair() && move2) {
+                if (snake2.checkCollision(gameMap, newhead2)) {
+                    if (version == advanced) {
+                        wallManager.addWall(gameMap, snake2.getBody());
+                    }
+                    else {
+                        foodManager.addFood(gameMap, rng, snake2.getBody());
+                    }
+
+                    if (!snake2.reset(gameMap, rng, snake2.getLife() - 1) || !foodManager.generateFood(gameMap, rng)) {
+                        ended = true;
+                    }
+                    restartClock(snake2);
+                }
+                else {
+                    snake2.move(gameMap);
+                }
+            }
+        }
+    }
+
+    // 根据生命值检测结束游戏
+    if (mode == singleMode && snake1.getLife() <= 0) {
+        ended = true;
+    }
+    else if (isPair() && snake1.getLife() <= 0 && snake2.getLife() <= 0) {
+        ended = true;
+    }
+
+    // 处理吃食物，根据食物计分
+    if (snake1.isEatState()) {
+        int tempScore = foodManager.getScore(newhead1);
+        if (tempScore == 5) {
+            clock.setSpeedUp(0);
+        }
+        // 加速状态下食物得分翻倍
+        score1 += tempScore * (clock.isSpeedUp(0) ? 2 : 1);
+        foodManager.removeFood(newhead1);
+        snake1.resetEat();
+    }
+    if (isPair() && snake2.isEatState()) {
+        int tempScore = foodManager.getScore(newhead2);
+        if (tempScore == 5) {
+            clock.setSpeedUp(1);
+        }
+        // 加速状态下食物得分翻倍
+        score2 += tempScore * (clock.isSpeedUp(1) ? 2 : 1);
+        foodManager.removeFood(newhead2);
+        snake2.resetEat();
+    }
+
+    // 更新新食物（没有食物了）
+    if (foodManager.foodEmpty()) {
+        if (!foodManager.generateFood(gameMap, rng)) {
+            // 地图已满，游戏结束
+            ended = true;
+        }
+    }
+}
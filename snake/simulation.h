@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "config.h"
+#include "food.h"
+#include "gamemap.h"
+#include "move_clock.h"
+#include "rng.h"
+#include "snake.h"
+#include "wall.h"
+
+// 输入源接口：界面层由键盘提供，无界面的模拟/测试可注入脚本输入
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    // 取出下一个指定类型的按键（每个按键只返回一次），没有时返回 (-1, none)
+    // 规则引擎每帧会反复调用直到返回 none
+    virtual std::pair<int, keyStatus> getKey(keyStatus keyType) = 0;
+
+    // 上一次 getKey 返回的按键的读入时刻（单位由输入源自定），没有记录时为 0
+    virtual long long keyStamp() const {
+        return 0;
+    }
+
+    // 带读入时刻的转向真正生效（蛇转向）时由规则引擎回调，用于统计从按键到蛇转向的延迟
+    virtual void turnApplied(int /*player*/, long long /*stamp*/) {
+    }
+};
+
+// 一次生效的转向：玩家编号与转向后的方向
+struct TurnEvent {
+    int player;
+    Direction dir;
+};
+
+// 游戏规则引擎：不依赖任何图形库与系统时钟，按固定步长逐帧推进
+class Simulation {
+private:
+    // 地图的各个元素
+    GameMap gameMap;
+    Snake snake1, snake2;
+    // 两条蛇的移动节奏，下标 0 为蛇1，1 为蛇2
+    MoveClock clock;
+    FoodManager foodManager;
+    WallManager wallManager;
+
+    // 当前对局的模式与版本
+    GameState mode;
+    GameVersion version;
+
+    // 本局的随机种子与随机数发生器，同一种子和输入可完全复现一局
+    uint64_t seed;
+    Rng rng;
+
+    // 已推进的帧数，游戏时间由帧数换算（暂停时不推进，自然不计入）
+    long long tickCount;
+
+    int score1, score2;
+    bool ended;
+
+    // 本帧由按键引起且真正生效的转向，供录像使用
+    TurnEvent turns[2];
+    int turnCount;
+
+    // 把这一帧的按键全部读出，排进蛇的转向队列
+    void drainKeys(Snake& snake, InputSource& input, keyStatus keyType);
+    // 蛇移动前应用一个排队的转向，方向发生变化时记入 turns，并把按键的读入时刻交还输入源
+    void applyTurn(Snake& snake, InputSource& input);
+    // 蛇重置（重生或死亡）后同步它的移动节奏
+    void restartClock(const Snake& snake);
+
+public:
+    // 地图尺寸可在运行时指定，默认与界面一致
+    Simulation(int width = mapWidth, int height = mapHeight)
+        : gameMap(width, height), snake1(1, width * height), snake2(2, width * height), clock(2), foodManager(width, height),
+        mode(singleMode), version(beginner), seed(1), tickCount(0), score1(0), score2(0), ended(false), turnCount(0) {
+    }
+
+    // 按模式、版本和随机种子开始新的一局
+    void init(GameState mode_, GameVersion version_, uint64_t seed_ = 1);
+
+    // 推进一帧：每帧把输入源中的方向键读进转向队列，蛇移动的那一帧取出一个生效
+    void update(InputSource& input);
+
+    // 快进：直接跳过接下来没有蛇移动的空帧，最多 maxTicks 帧，返回跳过的帧数
+    // 空帧里不读取按键，只适合只在蛇移动的那一帧给出转向的输入源（电脑玩家、录像回放）
+    long long skipIdleTicks(long long maxTicks);
+
+    // 完成一帧中读取按键及之后的部分。update 在读取按键时（InputSource::getKey 里）复制出的对局
+    // 停在帧的中间，搜索从这样的副本出发时先调用它补完这一帧，之后再照常 update
+    void finishTick(InputSource& input);
+
+    bool isPair() const {
+        return mode == pairMode;
+    }
+
+    // 上一帧生效的转向数与内容
+    int getTurnCount() const {
+        return turnCount;
+    }
+
+    const TurnEvent& getTurn(int i) const {
+        return turns[i];
+    }
+
+    bool isEnded() const {
+        return ended;
+    }
+
+    long long getTickCount() const {
+        return tickCount;
+    }
+
+    // 已进行的游戏时间（毫秒），精确到一帧
+    long long getGameTimeMs() const {
+        return tickCount * frameInterval;
+    }
+
+    int getScore1() const {
+        return score1;
+    }
+
+    int getScore2() const {
+        return score2;
+    }
+
+    // 玩家这一帧是否移动（update 读取按键时有效）、是否处于加速状态
+    bool isMovingThisFrame(int player) const {
+        return clock.isMoving(player - 1);
+    }
+
+    bool isSpeedUp(int player) const {
+        return clock.isSpeedUp(player - 1);
+    }
+
+    uint64_t getSeed() const {
+        return seed;
+    }
+
+    GameState getMode() const {
+        return mode;
+    }
+
+    GameVersion getVersion() const {
+        return version;
+    }
+
+    // 增量渲染：开启地图的变化格子记录，渲染后清除
+    void setDirtyTracking(bool on) {
+        gameMap.setDirtyTracking(on);
+    }
+
+    void clearDirty() {
+        gameMap.clearDirty();
+    }
+
+    // 设置两条蛇的转向队列深度
+    void setTurnQueueDepth(int depth) {
+        snake1.setTurnQueueDepth(depth);
+        snake2.setTurnQueueDepth(depth);
+    }
+
+    const GameMap& getMap() const {
+        return gameMap;
+    }
+
+    const Snake& getSnake1() const {
+        return snake1;
+    }
+
+    const Snake& getSnake2() const {
+        return snake2;
+    }
+
+    const FoodManager& getFoodManager() const {
+        return foodManager;
+    }
+
+    const WallManager& getWallManager() const {
+        return wallManager;
+    }
+};
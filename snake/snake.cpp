@@ -0,0 +1,186 @@
+#include "snake.h"
+
+using namespace std;
+
+pair<int, int> Snake::findNewHead() const {
+    if (body.empty() || life <= 0) {
+        // 返回无效位置
+        return make_pair(-1, -1);
+    }
+
+    auto head = body.front();
+    int newX = head.first;
+    int newY = head.second;
+
+    switch (dir) {
+    case up:    newY--; break;
+    case down:  newY++; break;
+    case left_dir:  newX--; break;
+    case right_dir: newX++; break;
+    case stop: break;
+    }
+
+    return make_pair(newX, newY);
+}
+
+void Snake::move(GameMap& map) {
+    if (life <= 0 || body.empty()) {
+        return;
+    }
+
+    pair<int, int> newHead = findNewHead();
+
+    // 将新头部加入队列
+    body.push_front(newHead);
+
+    // 如果没有吃到食物，移除尾部
+    if (map.get(newHead.first, newHead.second) != food) {
+        isEat = false;
+        auto tail = body.back();
+        map.set(tail.first, tail.second, emptyInfo);
+        body.pop_back();
+    }
+    else {
+        isEat = true;
+    }
+
+    map.set(newHead.first, newHead.second, (playerId == 1) ? snake1Body : snake2Body);
+}
+
+Direction oppositeDirection(Direction d) {
+    static const Direction opposite[5] = { stop, down, up, right_dir, left_dir };
+    return opposite[d];
+}
+
+bool isOpposite(Direction a, Direction b) {
+    return (a == up && b == down) || (a == down && b == up)
+        || (a == left_dir && b == right_dir) || (a == right_dir && b == left_dir);
+}
+
+Direction Snake::keyDirection(pair<int, keyStatus> key) const {
+    // 玩家1使用WASD
+    if (playerId == 1 && key.second == p1) {
+        switch (key.first) {
+        case 'W': case 'w': return up;
+        case 'S': case 's': return down;
+        case 'A': case 'a': return left_dir;
+        case 'D': case 'd': return right_dir;
+        }
+    }
+    // 玩家2使用箭头键
+    else if (playerId == 2 && key.second == p2) {
+        switch (key.first) {
+        case VK_UP:    return up;
+        case VK_DOWN:  return down;
+        case VK_LEFT:  return left_dir;
+        case VK_RIGHT: return right_dir;
+        }
+    }
+    return stop;
+}
+
+pair<int, keyStatus> keyForDirection(int player, Direction dir) {
+    static const int p1Keys[5] = { -1, 'W', 'S', 'A', 'D' };
+    static const int p2Keys[5] = { -1, VK_UP, VK_DOWN, VK_LEFT, VK_RIGHT };
+    if (player == 1) {
+        return make_pair(p1Keys[dir], p1);
+    }
+    return make_pair(p2Keys[dir], p2);
+}
+
+void Snake::changeDirection(pair<int, keyStatus> key) {
+    // 如果死亡，则不改变方向
+    if (life <= 0 || body.empty()) return;
+
+    Direction d = keyDirection(key);
+    if (d != stop && !isOpposite(d, dir)) {
+        dir = d;
+    }
+}
+
+void Snake::queueTurn(pair<int, keyStatus> key, long long stamp) {
+    queueDirection(keyDirection(key), stamp);
+}
+
+void Snake::queueDirection(Direction d, long long stamp) {
+    if (life <= 0 || body.empty()) return;
+
+    Direction last = turnCount ? turnQueue[(turnHead + turnCount - 1) % maxTurnQueueDepth] : dir;
+    if (d == stop || d == last || isOpposite(d, last) || turnCount == turnDepth) {
+        return;
+    }
+    int slot = (turnHead + turnCount) % maxTurnQueueDepth;
+    turnQueue[slot] = d;
+    turnStamp[slot] = stamp;
+    ++turnCount;
+}
+
+long long Snake::applyQueuedTurn() {
+    if (turnCount == 0) {
+        return 0;
+    }
+    Direction d = turnQueue[turnHead];
+    long long stamp = turnStamp[turnHead];
+    turnHead = (turnHead + 1) % maxTurnQueueDepth;
+    --turnCount;
+    // 入队时已按队尾检查过，这里再防一次掉头
+    if (isOpposite(d, dir)) {
+        return 0;
+    }
+    dir = d;
+    return stamp;
+}
+
+void Snake::setTurnQueueDepth(int depth) {
+    turnDepth = depth < 1 ? 1 : depth > maxTurnQueueDepth ? maxTurnQueueDepth : depth;
+    turnHead = turnCount = 0;
+}
+
+bool Snake::isTail(pair<int, int> pos) const {
+    auto tail = body.back();
+    return tail.first == pos.first && tail.second == pos.second;
+}
+
+bool Snake::checkCollision(const GameMap& map, pair<int, int> pos) const {
+    if (!map.inBounds(pos.first, pos.second)) {
+        return true;
+    }
+    MapElement e = map.get(pos.first, pos.second);
+    if ((e == snake1Body && !isTail(pos))
+        || (e == snake2Body && !isTail(pos))
+        || (e == wall)) {
+        return true;
+    }
+    return false;
+}
+
+bool Snake::reset(GameMap& map, Rng& rng, int life_) {
+    Direction newDir = static_cast<Direction>(rng.below(4) + 1);
+    return reset(map, rng, life_, newDir);
+}
+
+bool Snake::reset(GameMap& map, Rng& rng, int life_, Direction newDir) {
+    body.clear();
+    // 之前排队的转向是针对旧方向的，全部作废
+    turnHead = turnCount = 0;
+    if (life_ < 0) {
+        return true;
+    }
+    if (life_ == 0) {
+        life = 0;
+        return true;
+    }
+    auto newPos = map.getRandomEmptyPosition(rng);
+
+    // 无法重置，地图已满
+    if (newPos.first == -1) {
+        return false;
+    }
+
+    body.push_back(newPos);
+    map.set(newPos.first, newPos.second, (playerId == 1) ? snake1Body : snake2Body);
+    dir = newDir;
+    isEat = false;
+    life = life_;
+    return true;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <utility>
+
+#include "config.h"
+#include "gamemap.h"
+#include "rng.h"
+#include "snakebody.h"
+
+// 各方向的坐标增量，下标为 Direction
+const int dirX[5] = { 0, 0, 0, -1, 1 };
+const int dirY[5] = { 0, -1, 1, 0, 0 };
+
+// 反方向，stop 的反方向仍是 stop
+Direction oppositeDirection(Direction d);
+
+// 两个方向是否相反
+bool isOpposite(Direction a, Direction b);
+
+// 把方向还原成对应玩家的按键（玩家1 WASD，玩家2 方向键）
+std::pair<int, keyStatus> keyForDirection(int player, Direction dir);
+
+// 蛇类（只包含游戏逻辑，绘制由界面层负责）
+class Snake {
+private:
+    // 环形缓冲区存放蛇身，头尾操作不分配内存
+    SnakeBody body;
+    // 贪吃蛇的移动方向
+    Direction dir;
+    // 玩家1 or 2（竞技场中为蛇的编号加 1）
+    int playerId;
+    // 蛇的生命值
+    int life;
+    //是否吃到食物
+    bool isEat;
+    // 加速与移动间隔等每帧都要更新的状态由规则引擎的 MoveClock 按结构体数组统一管理
+
+    // 转向队列：两次移动之间按下的转向先排队，每次移动取出一个
+    // 入队时与队尾（队列为空则与当前方向）比较，重复和掉头的转向直接丢弃
+    Direction turnQueue[maxTurnQueueDepth];
+    // 每个排队转向对应按键的读入时刻（由输入源给出，0 表示没有记录），转向生效时用来统计延迟
+    long long turnStamp[maxTurnQueueDepth];
+    int turnHead, turnCount, turnDepth;
+
+    // 按键对应的方向，不是本玩家的键返回 stop
+    Direction keyDirection(std::pair<int, keyStatus> key) const;
+
+public:
+    // maxLength 为蛇身最大长度，一般为地图格子数
+    Snake(int playerID, int maxLength = mapWidth * mapHeight)
+        : body(maxLength), dir(stop), playerId(playerID), life(1), isEat(false),
+        turnHead(0), turnCount(0), turnDepth(turnQueueDepth) {
+    }
+
+    // 计算蛇头新位置
+    std::pair<int, int> findNewHead() const;
+
+    // 蛇移动函数
+    void move(GameMap& map);
+
+    // 改变蛇的移动方向
+    void changeDirection(std::pair<int, keyStatus> key);
+
+    // 把按键排进转向队列，队列满时丢弃；stamp 为按键的读入时刻
+    void queueTurn(std::pair<int, keyStatus> key, long long stamp = 0);
+
+    // 把方向直接排进转向队列（电脑玩家与竞技场里没有对应按键的蛇）
+    void queueDirection(Direction d, long long stamp = 0);
+
+    // 移动前调用，取出一个排队的转向并应用；返回这个转向入队时的读入时刻，没有转向生效时返回 0
+    long long applyQueuedTurn();
+
+    // 设置转向队列深度（1 ~ maxTurnQueueDepth），清空已排队的转向
+    void setTurnQueueDepth(int depth);
+
+    int getQueuedTurns() const {
+        return turnCount;
+    }
+
+    // 检测是否为尾部位置,主要用于newHead正好为当前蛇尾部位置的情况
+    bool isTail(std::pair<int, int> pos) const;
+
+    // 检测碰撞
+    bool checkCollision(const GameMap& map, std::pair<int, int> pos) const;
+
+    // 重置蛇的位置和状态，初始方向随机生成
+    bool reset(GameMap& map, Rng& rng, int life_);
+
+    // 重置蛇的位置和状态，使用指定的初始方向
+    bool reset(GameMap& map, Rng& rng, int life_, Direction newDir);
+
+    // 获取是否吃到食物状态
+    bool isEatState() const {
+        return isEat;
+    }
+
+    // 重置吃到食物状态
+    void resetEat() {
+        isEat = false;
+    }
+
+    // 获取蛇身体位置
+    const SnakeBody& getBody() const {
+        return body;
+    }
+
+    // 获取蛇头位置
+    std::pair<int, int> getHeadPos() const {
+        if (body.empty()) {
+            return std::make_pair(-2, -2); // 返回无效位置
+        }
+        return body.front();
+    }
+
+    // 获取蛇的生命值
+    int getLife() const {
+        return life;
+    }
+
+    // 获取玩家编号
+    int getPlayerId() const {
+        return playerId;
+    }
+
+    // 获取当前移动方向
+    Direction getDirection() const {
+        return dir;
+    }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 蛇身坐标打包为 32 位：低 16 位为 x，高 16 位为 y
+inline uint32_t packPos(int x, int y) {
+    return static_cast<uint32_t>(x) | (static_cast<uint32_t>(y) << 16);
+}
+
+inline std::pair<int, int> unpackPos(uint32_t p) {
+    return std::make_pair(static_cast<int>(p & 0xFFFF), static_cast<int>(p >> 16));
+}
+
+// 蛇身：容量为 2 的幂的环形缓冲区，下标 0 为蛇头
+// 容量一般在构造时按地图格子数确定，移动时只改头尾下标，不再分配内存；
+// 竞技场里蛇很多，只预留较小的容量，装满时翻倍
+class SnakeBody {
+public:
+    // 一段连续存放的蛇身坐标
+    struct Span {
+        const uint32_t* data;
+        size_t size;
+    };
+
+private:
+    std::vector<uint32_t> ring;
+    size_t mask;
+    // 蛇头在 ring 中的位置
+    size_t head;
+    size_t count;
+
+public:
+    // maxLength 为蛇身可能达到的最大长度
+    explicit SnakeBody(size_t maxLength) : head(0), count(0) {
+        // 移动时先加头再去尾，需要多留一格
+        size_t capacity = 1;
+        while (capacity < maxLength + 1) {
+            capacity <<= 1;
+        }
+        ring.resize(capacity);
+        mask = capacity - 1;
+    }
+
+    // 容量翻倍，蛇身从新缓冲区的开头依次存放
+    void grow() {
+        std::vector<uint32_t> bigger(ring.size() * 2);
+        for (size_t i = 0; i < count; ++i) {
+            bigger[i] = ring[(head + i) & mask];
+        }
+        ring.swap(bigger);
+        mask = ring.size() - 1;
+        head = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void clear() {
+        count = 0;
+    }
+
+    void push_front(std::pair<int, int> pos) {
+        if (count == ring.size()) {
+            grow();
+        }
+        head = (head - 1) & mask;
+        ring[head] = packPos(pos.first, pos.second);
+        ++count;
+    }
+
+    void push_back(std::pair<int, int> pos) {
+        if (count == ring.size()) {
+            grow();
+        }
+        ring[(head + count) & mask] = packPos(pos.first, pos.second);
+        ++count;
+    }
+
+    void pop_back() {
+        --count;
+    }
+
+    std::pair<int, int> front() const {
+        return unpackPos(ring[head]);
+    }
+
+    std::pair<int, int> back() const {
+        return unpackPos(ring[(head + count - 1) & mask]);
+    }
+
+    std::pair<int, int> operator[](size_t i) const {
+        return unpackPos(ring[(head + i) & mask]);
+    }
+
+    // 以最多两段连续内存的形式访问蛇身（从头到尾），返回段数
+    int segments(Span out[2]) const {
+        if (count == 0) {
+            return 0;
+        }
+        size_t firstLen = ring.size() - head;
+        if (count <= firstLen) {
+            out[0] = Span{ ring.data() + head, count };
+            return 1;
+        }
+        out[0] = Span{ ring.data() + head, firstLen };
+        out[1] = Span{ ring.data(), count - firstLen };
+        return 2;
+    }
+};
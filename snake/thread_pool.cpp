@@ -0,0 +1,135 @@
+#include "thread_pool.h"
+
+using namespace std;
+
+namespace {
+
+// 当前线程所属的线程池与编号，不是工作线程时为空
+thread_local ThreadPool* workerPool = nullptr;
+thread_local int workerId = 0;
+
+}
+
+ThreadPool::ThreadPool(int threadCount) : queued(0), stopping(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(thread::hardware_concurrency());
+        if (threadCount <= 0) {
+            threadCount = 1;
+        }
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(unique_ptr<WorkQueue>(new WorkQueue));
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(idleLock);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+bool ThreadPool::takeTask(int id, function<void()>& task) {
+    int n = static_cast<int>(queues.size());
+    for (int k = 0; k < n; ++k) {
+        WorkQueue& q = *queues[(id + k) % n];
+        lock_guard<mutex> guard(q.lock);
+        if (q.tasks.empty()) {
+            continue;
+        }
+        if (k == 0) {
+            task = move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        else {
+            task = move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::runTask(int id) {
+    function<void()> task;
+    if (!takeTask(id, task)) {
+        return false;
+    }
+    {
+        lock_guard<mutex> guard(idleLock);
+        --queued;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::finishTask(int& remaining) {
+    lock_guard<mutex> guard(doneLock);
+    if (--remaining == 0) {
+        allDone.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(int id) {
+    workerPool = this;
+    workerId = id;
+    while (true) {
+        {
+            unique_lock<mutex> guard(idleLock);
+            wakeUp.wait(guard, [this] { return queued > 0 || stopping; });
+            if (queued == 0 && stopping) {
+                return;
+            }
+        }
+        runTask(id);
+    }
+}
+
+void ThreadPool::parallelFor(int count, int grain, const function<void(int, int)>& fn) {
+    if (count <= 0) {
+        return;
+    }
+    if (grain <= 0) {
+        grain = 1;
+    }
+    int chunks = (count + grain - 1) / grain;
+    // 这一批还没执行完的任务数，只由 doneLock 保护
+    int remaining = chunks;
+
+    // 按轮转方式分发到各线程的队列
+    int n = static_cast<int>(queues.size());
+    for (int c = 0; c < chunks; ++c) {
+        int begin = c * grain;
+        int end = (begin + grain < count) ? begin + grain : count;
+        WorkQueue& q = *queues[c % n];
+        lock_guard<mutex> guard(q.lock);
+        q.tasks.push_back([this, &fn, &remaining, begin, end] {
+            fn(begin, end);
+            finishTask(remaining);
+        });
+    }
+    {
+        lock_guard<mutex> guard(idleLock);
+        queued += chunks;
+    }
+    wakeUp.notify_all();
+
+    // 工作线程在任务里调用时先帮忙执行任务，队列空了说明这一批都已被取走，再等它们完成
+    if (workerPool == this) {
+        while (runTask(workerId)) {
+            lock_guard<mutex> guard(doneLock);
+            if (remaining == 0) {
+                return;
+            }
+        }
+    }
+    unique_lock<mutex> guard(doneLock);
+    allDone.wait(guard, [&remaining] { return remaining == 0; });
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 工作窃取线程池：每个工作线程有自己的任务队列，自己的队列空了就去别的队列尾部偷任务
+// 可以有多个调用者同时提交，任务里也可以再调用 parallelFor
+class ThreadPool {
+private:
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    // 已提交但还没被取走的任务数，用于唤醒空闲线程
+    std::mutex idleLock;
+    std::condition_variable wakeUp;
+    int queued;
+    bool stopping;
+
+    // 每次 parallelFor 各自记录还没执行完的任务数，任务完成时通知等待的调用者
+    std::mutex doneLock;
+    std::condition_variable allDone;
+
+    // 先取自己队列头部的任务，没有再从其他队列尾部窃取
+    bool takeTask(int id, std::function<void()>& task);
+    // 取出并执行一个任务，没有任务时返回 false
+    bool runTask(int id);
+    void workerLoop(int id);
+    void finishTask(int& remaining);
+
+public:
+    // threadCount <= 0 时使用全部硬件线程
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int size() const {
+        return static_cast<int>(threads.size());
+    }
+
+    // 把 [0, count) 按 grain 切块后并行执行 fn(begin, end)，阻塞直到这一批全部完成
+    // 在任务里调用时，等待期间这个工作线程会继续执行队列里的任务，不会因工作线程都在等待而死锁
+    void parallelFor(int count, int grain, const std::function<void(int, int)>& fn);
+};
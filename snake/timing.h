@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+
+// 两个时刻之间的毫秒数
+inline double elapsedMs(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// 耗时统计：次数、平均值与最大值（毫秒）
+struct TimingStat {
+    long long count;
+    double total;
+    double maxValue;
+
+    TimingStat() {
+        reset();
+    }
+
+    void reset() {
+        count = 0;
+        total = 0;
+        maxValue = 0;
+    }
+
+    void add(double ms) {
+        ++count;
+        total += ms;
+        if (ms > maxValue) {
+            maxValue = ms;
+        }
+    }
+
+    double average() const {
+        return count ? total / count : 0;
+    }
+};
+
+// 每局的帧统计：逻辑更新耗时、渲染耗时、按键到生效的延迟
+struct FrameStats {
+    TimingStat update;
+    TimingStat render;
+    TimingStat inputLatency;
+    // 渲染帧数、逻辑帧数，以及因追赶上限被丢弃的逻辑帧数
+    long long frames;
+    long long ticks;
+    long long droppedTicks;
+
+    FrameStats() {
+        reset();
+    }
+
+    void reset() {
+        update.reset();
+        render.reset();
+        inputLatency.reset();
+        frames = ticks = droppedTicks = 0;
+    }
+};
+
+// 固定步长累加器：逻辑帧按固定间隔推进，与渲染帧率无关
+// 渲染慢时一帧内追赶多个逻辑帧（跳过中间的渲染），但每帧最多追赶 maxSteps 个，避免越追越慢
+class FixedStep {
+private:
+    double stepMs;
+    int maxSteps;
+    double accumulator;
+
+public:
+    FixedStep(double stepMs_, int maxSteps_) : stepMs(stepMs_), maxSteps(maxSteps_), accumulator(0) {
+    }
+
+    void reset() {
+        accumulator = 0;
+    }
+
+    // 累加经过的时间，返回本帧应推进的逻辑帧数；超出追赶上限的部分丢弃，由 dropped 返回
+    int advance(double elapsedMs, int& dropped) {
+        accumulator += elapsedMs;
+        int steps = static_cast<int>(accumulator / stepMs);
+        accumulator -= steps * stepMs;
+        dropped = 0;
+        if (steps > maxSteps) {
+            dropped = steps - maxSteps;
+            steps = maxSteps;
+        }
+        return steps;
+    }
+
+    // 距离下一个逻辑帧还有多少毫秒
+    double untilNextStep() const {
+        return stepMs - accumulator;
+    }
+};
@@ -0,0 +1,40 @@
+#include "wall.h"
+
+using namespace std;
+
+void WallManager::reset(GameMap& map) {
+    int mapWidth = map.getWidth();
+    int mapHeight = map.getHeight();
+    wallList.clear();
+    // 每格最多记录一堵墙，第一局预留满容量，之后尸体变墙不再扩容
+    wallList.reserve(map.getCellCount());
+    for (int i = 0; i < mapWidth; ++i) {
+        wallList.push_back(make_pair(i, 0));
+        wallList.push_back(make_pair(i, mapHeight - 1));
+        map.set(i, 0, wall);
+        map.set(i, mapHeight - 1, wall);
+    }
+    // 四个角已在上面记录过
+    for (int j = 1; j < mapHeight - 1; ++j) {
+        wallList.push_back(make_pair(0, j));
+        wallList.push_back(make_pair(mapWidth - 1, j));
+        map.set(0, j, wall);
+        map.set(mapWidth - 1, j, wall);
+    }
+}
+
+void WallManager::addWall(GameMap& map, const SnakeBody& body) {
+    SnakeBody::Span spans[2];
+    int n = body.segments(spans);
+    for (int s = 0; s < n; ++s) {
+        for (size_t i = 0; i < spans[s].size; ++i) {
+            auto pos = unpackPos(spans[s].data[i]);
+            // 蛇头相撞时两条蛇的蛇头可能在同一格，已经是墙的格子不再记录
+            if (map.get(pos.first, pos.second) == wall) {
+                continue;
+            }
+            wallList.push_back(pos);
+            map.set(pos.first, pos.second, wall);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "gamemap.h"
+#include "snakebody.h"
+
+// 墙管理器类（只包含游戏逻辑，绘制由界面层负责）
+class WallManager {
+private:
+    std::vector<std::pair<int, int>> wallList;
+
+public:
+    // 重置墙壁，只保留四周边界
+    void reset(GameMap& map);
+
+    // 添加墙壁
+    void addWall(GameMap& map, const SnakeBody& body);
+
+    // 获取全部墙壁，供绘制使用
+    const std::vector<std::pair<int, int>>& getWalls() const {
+        return wallList;
+    }
+};